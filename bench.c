@@ -0,0 +1,266 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "hex.h"
+#include "bitboard.h"
+#include "playout.h"
+
+// Microbenchmarks del motor sin Raylib. Cada medicion es una linea separada por
+// tabuladores (bench, size, threads, iters, seconds, value, unit) para comparar
+// corridas con otras herramientas; las lineas que empiezan con '#' son comentarios.
+// Las posiciones salen de una semilla fija, asi que dos corridas miden lo mismo.
+
+// Tableros llenos al azar para board_test (siempre tienen ganador)
+#define FULL_BOARDS 64
+// Partidas por llamada a playout_run_batch
+#define BATCH 64
+
+typedef struct {
+	int sizes[MAX_BOARD_SIDE + 1];
+	int size_count;
+	int threads;
+	int64_t nsim;
+	int reps;
+	double min_ms;
+	uint64_t seed;
+	int run_test;
+	int run_playout;
+	int run_stats;
+} bench_config_t;
+
+// Evita que el compilador descarte los resultados de las llamadas medidas
+static volatile int64_t bench_sink;
+
+static void report(const char *bench, int size, int threads, int64_t iters, double ms, double value, const char *unit) {
+	printf("%s\t%d\t%d\t%lld\t%.6f\t%.6g\t%s\n", bench, size, threads, (long long)iters, ms / 1000.0, value, unit);
+	fflush(stdout);
+}
+
+// Medio juego fijo: size*size/6 fichas por color en casillas al azar, sin ganador.
+// Juega X primero, asi que le toca a X.
+static void fixed_position(char *board, int size, uint64_t seed) {
+	pcg32_random_t rng;
+	pcg32_srandom_r(&rng, seed, (uint64_t)size);
+	board_clear(board, size);
+	int stones = size * size / 6;
+	for (int k = 0; k < 2 * stones; k++) {
+		char player = (k % 2 == 0) ? 'X' : 'O';
+		for (int tries = 0; tries < 64; tries++) {
+			int pos = (int)pcg32_boundedrand_r(&rng, (uint32_t)(size * size));
+			if (board[pos] != '+') continue;
+			board[pos] = player;
+			if (board_test(board, size) == '+') break;
+			board[pos] = '+';
+		}
+	}
+}
+
+// Dos posiciones hermanas (la fija mas una ficha de X en casillas distintas): ninguna
+// contiene a la otra, asi que el arbol UCT no reutiliza nada al alternarlas y cada
+// busqueda empieza en frio.
+static void sibling_positions(char boards[2][MAX_BOARD_SIZE], int size, uint64_t seed) {
+	fixed_position(boards[0], size, seed);
+	memcpy(boards[1], boards[0], (size_t)(size * size));
+	int found = 0;
+	for (int pos = size * size / 2; pos < size * size && found < 2; pos++) {
+		if (boards[0][pos] != '+') continue;
+		boards[found][pos] = 'X';
+		found++;
+	}
+}
+
+static void full_boards(char boards[FULL_BOARDS][MAX_BOARD_SIZE], int size, uint64_t seed) {
+	pcg32_random_t rng;
+	pcg32_srandom_r(&rng, seed, 1000u + (uint64_t)size);
+	for (int b = 0; b < FULL_BOARDS; b++) {
+		for (int i = 0; i < size * size; i++) boards[b][i] = (pcg32_random_r(&rng) & 1u) ? 'X' : 'O';
+	}
+}
+
+static void bench_test(const bench_config_t *c, int size) {
+	static char boards[FULL_BOARDS][MAX_BOARD_SIZE];
+	char board[MAX_BOARD_SIZE];
+	position_t p;
+	int64_t iters = 0;
+	int64_t found = 0;
+	full_boards(boards, size, c->seed);
+	double start = clock_ms();
+	double elapsed = 0.0;
+	while (elapsed < c->min_ms) {
+		for (int b = 0; b < FULL_BOARDS; b++) found += board_test(boards[b], size);
+		iters += FULL_BOARDS;
+		elapsed = clock_ms() - start;
+	}
+	report("board_test", size, 1, iters, elapsed, (double)iters * 1000.0 / elapsed, "calls/s");
+
+	// La conexion sobre el medio juego fijo: sin ganador, la inundacion llega a su punto fijo
+	fixed_position(board, size, c->seed);
+	position_from_board(&p, board, size);
+	iters = 0;
+	start = clock_ms();
+	elapsed = 0.0;
+	while (elapsed < c->min_ms) {
+		for (int k = 0; k < 256; k++) {
+			found += position_has_connection(&p, size, 'X');
+			found += position_has_connection(&p, size, 'O');
+		}
+		iters += 512;
+		elapsed = clock_ms() - start;
+	}
+	report("has_connection", size, 1, iters, elapsed, (double)iters * 1000.0 / elapsed, "calls/s");
+	bench_sink += found;
+}
+
+static void bench_playout(const bench_config_t *c, int size) {
+	char board[MAX_BOARD_SIZE];
+	position_t p;
+	playout_root_t root;
+	pcg32_random_t rng;
+	int64_t iters = 0;
+	int64_t lost = 0;
+	fixed_position(board, size, c->seed);
+	position_from_board(&p, board, size);
+	playout_prepare(&root, &p, size, NULL);
+
+	pcg32_srandom_r(&rng, c->seed, 1);
+	double start = clock_ms();
+	double elapsed = 0.0;
+	while (elapsed < c->min_ms) {
+		for (int k = 0; k < BATCH; k++) lost += (playout_run(&root, 'X', &rng) == 'O');
+		iters += BATCH;
+		elapsed = clock_ms() - start;
+	}
+	report("playout", size, 1, iters, elapsed, (double)iters * 1000.0 / elapsed, "playouts/s");
+
+	pcg32_srandom_r(&rng, c->seed, 1);
+	iters = 0;
+	start = clock_ms();
+	elapsed = 0.0;
+	while (elapsed < c->min_ms) {
+		lost += playout_run_batch(&root, 'X', BATCH, &rng);
+		iters += BATCH;
+		elapsed = clock_ms() - start;
+	}
+	report("playout_batch", size, 1, iters, elapsed, (double)iters * 1000.0 / elapsed, "playouts/s");
+	bench_sink += lost;
+}
+
+// Latencia de game_stats (juega O) con el presupuesto fijo; la parada temprana esta
+// desactivada para que todas las llamadas hagan el mismo trabajo
+static void bench_stats(const bench_config_t *c, int size, engine_t engine, int threads) {
+	static char boards[2][MAX_BOARD_SIZE];
+	int64_t stats[MAX_BOARD_SIZE];
+	sibling_positions(boards, size, c->seed);
+	game_set_engine(engine);
+	game_set_threads(threads);
+	game_seed(c->seed, 0);
+	// Una busqueda de calentamiento reserva la arena del arbol fuera de la medicion
+	game_stats(boards[1], size, 'O', 1, stats);
+	double total = 0.0;
+	for (int r = 0; r < c->reps; r++) {
+		double start = clock_ms();
+		game_stats(boards[r % 2], size, 'O', (int)c->nsim, stats);
+		total += clock_ms() - start;
+		bench_sink += game_move(stats, size);
+	}
+	int64_t playouts = c->reps * c->nsim;
+	report(engine == ENGINE_UCT ? "stats_uct" : "stats_flat", size, threads, c->reps, total, total / c->reps, "ms/call");
+	report(engine == ENGINE_UCT ? "stats_uct_rate" : "stats_flat_rate", size, threads, playouts, total,
+		(double)playouts * 1000.0 / total, "playouts/s");
+}
+
+// Tamanos como lista separada por comas, con rangos: "7,9,11" o "7-26"
+static int parse_sizes(const char *text, bench_config_t *c) {
+	int seen[MAX_BOARD_SIDE + 1] = {0};
+	const char *s = text;
+	while (*s) {
+		char *end;
+		long lo = strtol(s, &end, 10);
+		long hi = lo;
+		if (end == s) return -1;
+		s = end;
+		if (*s == '-') {
+			hi = strtol(s + 1, &end, 10);
+			if (end == s + 1) return -1;
+			s = end;
+		}
+		if (lo < 2 || hi > MAX_BOARD_SIDE || lo > hi) return -1;
+		for (long n = lo; n <= hi; n++) seen[n] = 1;
+		if (*s == ',') s++;
+		else if (*s) return -1;
+	}
+	c->size_count = 0;
+	for (int n = 2; n <= MAX_BOARD_SIDE; n++) {
+		if (seen[n]) c->sizes[c->size_count++] = n;
+	}
+	return c->size_count > 0 ? 0 : -1;
+}
+
+static int parse_benches(const char *text, bench_config_t *c) {
+	c->run_test = strstr(text, "test") != NULL;
+	c->run_playout = strstr(text, "playout") != NULL;
+	c->run_stats = strstr(text, "stats") != NULL;
+	return (c->run_test || c->run_playout || c->run_stats) ? 0 : -1;
+}
+
+static void usage(const char *name) {
+	fprintf(stderr, "Uso: %s [-s tamanos] [-t hilos] [-n simulaciones] [-r repeticiones] [-m ms] [-b test,playout,stats]\n"
+		"       [--playout-policy auto|bridge|random] [--simd auto|avx2|sse2|scalar] [--seed N]\n", name);
+}
+
+int main(int argc, char **argv) {
+	bench_config_t c = {0};
+	long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	c.threads = (cpus < 1) ? 1 : (cpus > MAX_PROC ? MAX_PROC : (int)cpus);
+	c.nsim = 2000;
+	c.reps = 5;
+	c.min_ms = 250.0;
+	c.seed = 1;
+	parse_sizes("7,9,11,13,15,19,26", &c);
+	parse_benches("test,playout,stats", &c);
+	for (int i = 1; i < argc; i++) {
+		if (i + 1 >= argc) {
+			usage(argv[0]);
+			return 1;
+		}
+		const char *arg = argv[++i];
+		int bad = 0;
+		if (strcmp(argv[i - 1], "-s") == 0) bad = parse_sizes(arg, &c) != 0;
+		else if (strcmp(argv[i - 1], "-t") == 0) bad = (c.threads = atoi(arg)) < 1 || c.threads > MAX_PROC;
+		else if (strcmp(argv[i - 1], "-n") == 0) bad = (c.nsim = strtoll(arg, NULL, 10)) < 1 || c.nsim > INT32_MAX;
+		else if (strcmp(argv[i - 1], "-r") == 0) bad = (c.reps = atoi(arg)) < 1;
+		else if (strcmp(argv[i - 1], "-m") == 0) bad = (c.min_ms = atof(arg)) <= 0.0;
+		else if (strcmp(argv[i - 1], "-b") == 0) bad = parse_benches(arg, &c) != 0;
+		else if (strcmp(argv[i - 1], "--seed") == 0) c.seed = strtoull(arg, NULL, 0);
+		else if (strcmp(argv[i - 1], "--playout-policy") == 0) {
+			playout_policy_t policy;
+			bad = !playout_parse_policy(arg, &policy);
+			if (!bad) playout_set_policy(policy);
+		} else if (strcmp(argv[i - 1], "--simd") == 0) {
+			playout_kernel_t kernel;
+			bad = !playout_parse_kernel(arg, &kernel) || !playout_set_kernel(kernel);
+		} else bad = 1;
+		if (bad) {
+			usage(argv[0]);
+			return 1;
+		}
+	}
+	game_set_early_stop(0.0);
+	printf("# hex bench seed=%llu nsim=%lld reps=%d min_ms=%g policy=%s simd=%s mode=%s\n",
+		(unsigned long long)c.seed, (long long)c.nsim, c.reps, c.min_ms,
+		playout_policy_name(playout_get_policy()), playout_kernel_name(playout_get_kernel()),
+		playout_mode_name(playout_get_mode()));
+	printf("bench\tsize\tthreads\titers\tseconds\tvalue\tunit\n");
+	for (int k = 0; k < c.size_count; k++) {
+		int size = c.sizes[k];
+		if (c.run_test) bench_test(&c, size);
+		if (c.run_playout) bench_playout(&c, size);
+		if (c.run_stats) {
+			bench_stats(&c, size, ENGINE_FLAT, 1);
+			// Los hilos comparten el arbol UCT; el motor plano usa uno solo
+			for (int t = 1; t <= c.threads; t++) bench_stats(&c, size, ENGINE_UCT, t);
+		}
+	}
+	return 0;
+}
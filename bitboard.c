@@ -0,0 +1,100 @@
+#include "bitboard.h"
+
+void position_from_board(position_t *p, const char *board, int size) {
+	bs_clear(&p->x);
+	bs_clear(&p->o);
+	for (int i = 0; i < size * size; i++) {
+		if (board[i] == 'X') bs_set(&p->x, i);
+		else if (board[i] == 'O') bs_set(&p->o, i);
+	}
+}
+
+void position_to_board(const position_t *p, char *board, int size) {
+	for (int i = 0; i < size * size; i++) {
+		board[i] = position_cell(p, i);
+	}
+}
+
+// Columnas 0 y size-1 (para evitar que un desplazamiento cruce de fila) y los lados
+// propios del jugador: columnas para X, filas para O
+static void edge_masks(int size, int horizontal, bitset_t *first, bitset_t *last, bitset_t *start, bitset_t *goal) {
+	bs_clear(first);
+	bs_clear(last);
+	bs_clear(start);
+	bs_clear(goal);
+	for (int k = 0; k < size; k++) {
+		bs_set(first, k * size);
+		bs_set(last, k * size + size - 1);
+		bs_set(start, horizontal ? k * size : k);
+		bs_set(goal, horizontal ? k * size + size - 1 : (size - 1) * size + k);
+	}
+}
+
+// Busca un camino de fichas 'token' entre los lados propios
+// horizontal (X): columna 0 a columna size-1; vertical (O): fila 0 a fila size-1
+// El conjunto alcanzable desde el primer lado crece por desplazamientos de bits hasta
+// un punto fijo: T1 = {x, x-1} y T2 = {x, x+1} de cada fila; T1 bajado una fila y T2
+// subido una fila completan los seis vecinos. Sin pila ni divisiones por casilla.
+int position_has_connection(const position_t *p, int size, char token) {
+	if (!p || size <= 0) return 0;
+	const bitset_t *stones = position_color(p, token);
+	bitset_t first, last, start, goal;
+	uint64_t reach[BB_WORDS];
+	uint64_t t1[BB_WORDS];
+	uint64_t t2[BB_WORDS];
+	int words = (size * size + 63) / 64;
+	uint64_t any = 0;
+	edge_masks(size, token == 'X', &first, &last, &start, &goal);
+	for (int w = 0; w < words; w++) {
+		reach[w] = stones->w[w] & start.w[w];
+		any |= reach[w];
+	}
+	if (!any) return 0;
+	while (1) {
+		for (int w = 0; w < words; w++) {
+			uint64_t r = reach[w];
+			uint64_t lo = (w > 0) ? reach[w - 1] : 0;
+			uint64_t hi = (w + 1 < words) ? reach[w + 1] : 0;
+			t1[w] = r | (((r >> 1) | (hi << 63)) & ~last.w[w]);
+			t2[w] = r | (((r << 1) | (lo >> 63)) & ~first.w[w]);
+		}
+		uint64_t changed = 0;
+		uint64_t hit = 0;
+		for (int w = 0; w < words; w++) {
+			uint64_t down = t1[w] << size;
+			uint64_t up = t2[w] >> size;
+			if (w > 0) down |= t1[w - 1] >> (64 - size);
+			if (w + 1 < words) up |= t2[w + 1] << (64 - size);
+			uint64_t next = (t1[w] | t2[w] | down | up) & stones->w[w];
+			changed |= next ^ reach[w];
+			hit |= next & goal.w[w];
+			reach[w] = next;
+		}
+		if (hit) return 1;
+		if (!changed) return 0;
+	}
+}
+
+char position_test(const position_t *p, int size) {
+	if (position_has_connection(p, size, 'X')) return 'X';
+	if (position_has_connection(p, size, 'O')) return 'O';
+	return '+';
+}
+
+// Hash completo; las jugadas lo actualizan con hash ^= zobrist_key(jugador, casilla)
+uint64_t position_hash(const position_t *p, int size) {
+	uint64_t hash = zobrist_size_key(size);
+	for (int w = 0; w < BB_WORDS; w++) {
+		uint64_t x = p->x.w[w];
+		uint64_t o = p->o.w[w];
+		while (x) {
+			hash ^= zobrist_key('X', w * 64 + __builtin_ctzll(x));
+			x &= x - 1;
+		}
+		while (o) {
+			hash ^= zobrist_key('O', w * 64 + __builtin_ctzll(o));
+			o &= o - 1;
+		}
+	}
+	return hash;
+}
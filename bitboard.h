@@ -0,0 +1,92 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <stdint.h>
+#include <string.h>
+#include "hex.h"
+
+// Numero de palabras de 64 bits necesarias para el tablero maximo (26x26 = 676 bits)
+#define BB_WORDS ((MAX_BOARD_SIZE + 63) / 64)
+
+// Conjunto de casillas: el bit i corresponde a la casilla size*y+x
+typedef struct {
+	uint64_t w[BB_WORDS];
+} bitset_t;
+
+// Posicion empaquetada: un bitset por color. Cabe en 176 bytes (3 lineas de cache)
+typedef struct {
+	bitset_t x;
+	bitset_t o;
+} position_t;
+
+static inline void bs_clear(bitset_t *bs) {
+	memset(bs->w, 0, sizeof(bs->w));
+}
+
+static inline int bs_get(const bitset_t *bs, int pos) {
+	return (int)((bs->w[pos >> 6] >> (pos & 63)) & 1u);
+}
+
+static inline void bs_set(bitset_t *bs, int pos) {
+	bs->w[pos >> 6] |= (uint64_t)1 << (pos & 63);
+}
+
+static inline void bs_reset(bitset_t *bs, int pos) {
+	bs->w[pos >> 6] &= ~((uint64_t)1 << (pos & 63));
+}
+
+// Conjunto de todas las casillas de un tablero de lado size
+static inline void bs_board_mask(bitset_t *bs, int size) {
+	int cells = size * size;
+	for (int w = 0; w < BB_WORDS; w++) {
+		int lo = w * 64;
+		if (cells >= lo + 64) bs->w[w] = ~(uint64_t)0;
+		else if (cells > lo) bs->w[w] = ((uint64_t)1 << (cells - lo)) - 1;
+		else bs->w[w] = 0;
+	}
+}
+
+static inline int position_empty(const position_t *p, int pos) {
+	return !(((p->x.w[pos >> 6] | p->o.w[pos >> 6]) >> (pos & 63)) & 1u);
+}
+
+static inline char position_cell(const position_t *p, int pos) {
+	if (bs_get(&p->x, pos)) return 'X';
+	if (bs_get(&p->o, pos)) return 'O';
+	return '+';
+}
+
+// Coloca una ficha sin validar (el llamador garantiza que la casilla esta vacia)
+static inline void position_set(position_t *p, int pos, char player) {
+	bs_set(player == 'X' ? &p->x : &p->o, pos);
+}
+
+static inline const bitset_t *position_color(const position_t *p, char player) {
+	return player == 'X' ? &p->x : &p->o;
+}
+
+// Claves de Zobrist: una por (color, casilla) y una por tamano de tablero. Se derivan
+// con splitmix64 de una constante, asi no hay tabla que inicializar y cualquier
+// proceso o hilo obtiene las mismas claves.
+static inline uint64_t zobrist_mix(uint64_t z) {
+	z += 0x9E3779B97F4A7C15ull;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
+
+static inline uint64_t zobrist_key(char player, int pos) {
+	return zobrist_mix((uint64_t)pos * 2u + (player == 'O' ? 1u : 0u));
+}
+
+static inline uint64_t zobrist_size_key(int size) {
+	return zobrist_mix(0x5A0B0000u + (uint64_t)size);
+}
+
+void position_from_board(position_t *p, const char *board, int size);
+void position_to_board(const position_t *p, char *board, int size);
+int position_has_connection(const position_t *p, int size, char token);
+char position_test(const position_t *p, int size);
+uint64_t position_hash(const position_t *p, int size);
+
+#endif
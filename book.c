@@ -0,0 +1,103 @@
+#include "book.h"
+#include "bitboard.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+uint64_t book_key(uint64_t hash, char player) {
+	return player == 'O' ? hash ^ zobrist_mix(0x51DEu) : hash;
+}
+
+// Proyecta el libro; regresa 0 si el archivo es valido. Las entradas deben venir
+// ordenadas por clave (book_write las ordena): si no, la busqueda binaria fallaria
+// en silencio, asi que un archivo desordenado se rechaza al abrirlo.
+int book_open(book_t *book, const char *path) {
+	memset(book, 0, sizeof(*book));
+	int fd = open(path, O_RDONLY);
+	if (fd < 0) return -1;
+	struct stat st;
+	if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(book_header_t)) {
+		close(fd);
+		return -1;
+	}
+	void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED) return -1;
+	const book_header_t *header = map;
+	size_t expected = sizeof(book_header_t) + (size_t)header->count * sizeof(book_entry_t);
+	if (header->magic != BOOK_MAGIC || header->version != BOOK_VERSION || expected != (size_t)st.st_size) {
+		munmap(map, (size_t)st.st_size);
+		return -1;
+	}
+	const book_entry_t *entries = (const book_entry_t *)(header + 1);
+	for (uint32_t i = 1; i < header->count; i++) {
+		if (entries[i].key < entries[i - 1].key) {
+			munmap(map, (size_t)st.st_size);
+			return -1;
+		}
+	}
+	book->map = map;
+	book->length = (size_t)st.st_size;
+	book->entries = entries;
+	book->count = header->count;
+	return 0;
+}
+
+void book_close(book_t *book) {
+	if (book->map) munmap(book->map, book->length);
+	memset(book, 0, sizeof(*book));
+}
+
+// Busqueda binaria en entradas ordenadas: primer indice con clave >= key ('count' si no hay)
+uint32_t book_find(const book_entry_t *entries, uint32_t count, uint64_t key) {
+	uint32_t lo = 0;
+	uint32_t hi = count;
+	while (lo < hi) {
+		uint32_t mid = lo + (hi - lo) / 2;
+		if (entries[mid].key < key) lo = mid + 1;
+		else hi = mid;
+	}
+	return lo;
+}
+
+// Jugada del libro para la posicion o -1
+int book_lookup(const book_t *book, uint64_t hash, int size, char player) {
+	if (!book->entries) return -1;
+	uint64_t key = book_key(hash, player);
+	uint32_t lo = book_find(book->entries, book->count, key);
+	if (lo == book->count) return -1;
+	const book_entry_t *entry = &book->entries[lo];
+	if (entry->key != key || entry->size != size || entry->player != (uint8_t)player) return -1;
+	if (entry->move < 0 || entry->move >= size * size) return -1;
+	return entry->move;
+}
+
+static int entry_cmp(const void *a, const void *b) {
+	uint64_t ka = ((const book_entry_t *)a)->key;
+	uint64_t kb = ((const book_entry_t *)b)->key;
+	return (ka > kb) - (ka < kb);
+}
+
+// Ordena las entradas y escribe el archivo; con claves repetidas queda la de mas visitas
+int book_write(const char *path, book_entry_t *entries, uint32_t count) {
+	qsort(entries, count, sizeof(entries[0]), entry_cmp);
+	uint32_t unique = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		if (unique > 0 && entries[unique - 1].key == entries[i].key) {
+			if (entries[i].visits > entries[unique - 1].visits) entries[unique - 1] = entries[i];
+			continue;
+		}
+		entries[unique++] = entries[i];
+	}
+	FILE *file = fopen(path, "wb");
+	if (!file) return -1;
+	book_header_t header = {BOOK_MAGIC, BOOK_VERSION, unique, 0};
+	int ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+		(unique == 0 || fwrite(entries, sizeof(entries[0]), unique, file) == unique);
+	if (fclose(file) != 0) ok = 0;
+	return ok ? 0 : -1;
+}
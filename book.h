@@ -0,0 +1,43 @@
+#ifndef BOOK_H
+#define BOOK_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Libro de aperturas binario. Archivo = cabecera + entradas de 16 bytes ordenadas por
+// clave; se proyecta en memoria de solo lectura y se consulta por busqueda binaria.
+// La clave es el hash de Zobrist de la posicion (que ya incluye el tamano) mezclado
+// con el jugador en turno; el tamano se guarda aparte para descartar colisiones.
+#define BOOK_MAGIC 0x4B425848u
+#define BOOK_VERSION 1
+
+typedef struct {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t count;
+	uint32_t reserved;
+} book_header_t;
+
+typedef struct {
+	uint64_t key;
+	uint8_t size;
+	uint8_t player;
+	int16_t move;
+	uint32_t visits;
+} book_entry_t;
+
+typedef struct {
+	void *map;
+	size_t length;
+	const book_entry_t *entries;
+	uint32_t count;
+} book_t;
+
+uint64_t book_key(uint64_t hash, char player);
+int book_open(book_t *book, const char *path);
+void book_close(book_t *book);
+uint32_t book_find(const book_entry_t *entries, uint32_t count, uint64_t key);
+int book_lookup(const book_t *book, uint64_t hash, int size, char player);
+int book_write(const char *path, book_entry_t *entries, uint32_t count);
+
+#endif
@@ -0,0 +1,136 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hex.h"
+#include "book.h"
+
+// Construye un libro de aperturas analizando cada posicion con una busqueda profunda.
+// En los turnos del jugador del libro se guarda y se sigue la mejor jugada; en los del
+// rival se prueban todas sus respuestas. 'depth' cuenta las jugadas del libro por linea.
+
+// Las entradas se mantienen ordenadas por clave, como en el archivo, para buscarlas
+// con book_find mientras se construye
+typedef struct {
+	int size;
+	int depth;
+	int64_t nsim;
+	char player;
+	book_entry_t *entries;
+	uint32_t count;
+	uint32_t capacity;
+} builder_t;
+
+// Entrada de la clave o NULL
+static const book_entry_t *book_get(const builder_t *b, uint64_t key) {
+	uint32_t i = book_find(b->entries, b->count, key);
+	return (i < b->count && b->entries[i].key == key) ? &b->entries[i] : NULL;
+}
+
+static int book_add(builder_t *b, uint64_t key, int move, int64_t visits) {
+	if (b->count == b->capacity) {
+		uint32_t capacity = b->capacity ? b->capacity * 2 : 256;
+		book_entry_t *grown = realloc(b->entries, (size_t)capacity * sizeof(book_entry_t));
+		if (!grown) return -1;
+		b->entries = grown;
+		b->capacity = capacity;
+	}
+	uint32_t at = book_find(b->entries, b->count, key);
+	memmove(&b->entries[at + 1], &b->entries[at], (size_t)(b->count - at) * sizeof(book_entry_t));
+	b->count++;
+	book_entry_t *e = &b->entries[at];
+	e->key = key;
+	e->size = (uint8_t)b->size;
+	e->player = (uint8_t)b->player;
+	e->move = (int16_t)move;
+	e->visits = visits > UINT32_MAX ? UINT32_MAX : (uint32_t)visits;
+	return 0;
+}
+
+static int build(builder_t *b, char *board, uint64_t hash, char turn, int depth) {
+	int size = b->size;
+	char other = (turn == 'X') ? 'O' : 'X';
+	if (depth == 0 || board_test(board, size) != '+') return 0;
+	if (turn != b->player) {
+		for (int pos = 0; pos < size * size; pos++) {
+			if (board[pos] != '+') continue;
+			uint64_t next = hash;
+			place_token_hash(board, size, pos, turn, &next);
+			int r = build(b, board, next, other, depth);
+			board[pos] = '+';
+			if (r != 0) return r;
+		}
+		return 0;
+	}
+	uint64_t key = book_key(hash, turn);
+	const book_entry_t *known = book_get(b, key);
+	int move = -1;
+	if (!known) {
+		int64_t stats[MAX_BOARD_SIZE];
+		search_budget_t budget = {b->nsim, 0};
+		game_search(board, size, turn, &budget, stats);
+		move = game_move(stats, size);
+		if (move < 0 || book_add(b, key, move, stats[move]) != 0) return -1;
+		fprintf(stderr, "\r%u posiciones", b->count);
+	} else {
+		move = known->move;
+	}
+	uint64_t next = hash;
+	place_token_hash(board, size, move, turn, &next);
+	int r = build(b, board, next, other, depth - 1);
+	board[move] = '+';
+	return r;
+}
+
+static void usage(const char *name) {
+	fprintf(stderr, "Uso: %s -o archivo -s tamano [-d jugadas] [-n simulaciones] [-p X|O] [-t hilos] [--seed N]\n", name);
+}
+
+int main(int argc, char **argv) {
+	builder_t b = {0};
+	const char *output = NULL;
+	int threads = 1;
+	uint64_t seed = 1;
+	b.depth = 1;
+	b.nsim = 200000;
+	b.player = 'O';
+	for (int i = 1; i < argc; i++) {
+		if (i + 1 >= argc) {
+			usage(argv[0]);
+			return 1;
+		}
+		if (strcmp(argv[i], "-o") == 0) output = argv[++i];
+		else if (strcmp(argv[i], "-s") == 0) b.size = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-d") == 0) b.depth = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-n") == 0) b.nsim = strtoll(argv[++i], NULL, 10);
+		else if (strcmp(argv[i], "-p") == 0) b.player = argv[++i][0];
+		else if (strcmp(argv[i], "-t") == 0) threads = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--seed") == 0) seed = strtoull(argv[++i], NULL, 0);
+		else {
+			usage(argv[0]);
+			return 1;
+		}
+	}
+	if (!output || b.size < 2 || b.size > MAX_BOARD_SIDE || b.depth < 1 || b.nsim < 1 ||
+		(b.player != 'X' && b.player != 'O')) {
+		usage(argv[0]);
+		return 1;
+	}
+	char board[MAX_BOARD_SIZE];
+	board_clear(board, b.size);
+	game_seed(seed, 0);
+	game_set_threads(threads);
+	if (build(&b, board, board_hash(board, b.size), 'X', b.depth) != 0) {
+		fprintf(stderr, "\nSin memoria para el libro.\n");
+		free(b.entries);
+		return 1;
+	}
+	fprintf(stderr, "\n");
+	if (book_write(output, b.entries, b.count) != 0) {
+		fprintf(stderr, "No se pudo escribir %s.\n", output);
+		free(b.entries);
+		return 1;
+	}
+	printf("%u posiciones escritas en %s.\n", b.count, output);
+	free(b.entries);
+	return 0;
+}
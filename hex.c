@@ -1,4 +1,11 @@
 #include "hex.h"
+#include "bitboard.h"
+#include "playout.h"
+#include "mcts.h"
+#include "search.h"
+#include "inferior.h"
+#include <string.h>
+#include <time.h>
 #include <ctype.h>
 
 void board_print(const char* board, int size){
@@ -33,6 +40,20 @@ int place_token(char * board,int size,int pos,char player){
     return 1;
 }
 
+// Hash de Zobrist del tablero (mismas claves que el arbol de busqueda)
+uint64_t board_hash(const char * board,int size){
+    position_t p;
+    position_from_board(&p,board,size);
+    return position_hash(&p,size);
+}
+
+// Igual que place_token, y si la ficha se coloca actualiza 'hash' sin recalcularlo
+int place_token_hash(char * board,int size,int pos,char player,uint64_t* hash){
+    if(!place_token(board,size,pos,player)) return 0;
+    if(hash) *hash^=zobrist_key(player,pos);
+    return 1;
+}
+
 token_t board_status(const char * board,int size){
     char result = board_test(board,size);
     if(result=='X') return white;
@@ -48,63 +69,15 @@ void to_xy(int size, int ind,int* x,int* y){
 	*y=ind/size;
 	*x=ind%size;
 }
-static int board_has_connection(const char *board,int size,char token,int horizontal){
-	if(!board || size<=0) return 0;
-	int stack[MAX_STACK_SIZE];
-	char visited[MAX_BOARD_SIZE];
-	int top=0;
-	for(int i=0;i<size*size;i++) visited[i]=0;
-	if(horizontal){
-		for(int row=0;row<size;row++){
-			int pos=row*size;
-			if(board[pos]==token){
-				stack[top++]=pos;
-				visited[pos]=1;
-			}
-		}
-	}else{
-		for(int col=0;col<size;col++){
-			int pos=col;
-			if(board[pos]==token){
-				stack[top++]=pos;
-				visited[pos]=1;
-			}
-		}
-	}
-	if(top==0) return 0;
-	while(top>0){
-		int pos=stack[--top];
-		int x,y;
-		int nb[6];
-		to_xy(size,pos,&x,&y);
-		if(horizontal){
-			if(x==size-1) return 1;
-		}else{
-			if(y==size-1) return 1;
-		}
-		nb[0]=to_ind(size,x,y-1);
-		nb[1]=to_ind(size,x+1,y-1);
-		nb[2]=to_ind(size,x+1,y);
-		nb[3]=to_ind(size,x,y+1);
-		nb[4]=to_ind(size,x-1,y+1);
-		nb[5]=to_ind(size,x-1,y);
-		for(int i=0;i<6;i++){
-			if(nb[i]<0) continue;
-			if(visited[nb[i]]) continue;
-			if(board[nb[i]]==token){
-				stack[top++]=nb[i];
-				visited[nb[i]]=1;
-			}
-		}
-	}
-	return 0;
-}
-
 int board_test_x(const char * board,int size){
-	return board_has_connection(board,size,'X',1);
+	position_t p;
+	position_from_board(&p,board,size);
+	return position_has_connection(&p,size,'X');
 }
 int board_test_o(const char * board,int size){
-	return board_has_connection(board,size,'O',0);
+	position_t p;
+	position_from_board(&p,board,size);
+	return position_has_connection(&p,size,'O');
 }
 // Evalua el estado del tablero
 // Regresa:
@@ -116,89 +89,394 @@ char board_test(const char* board,int size){
 	if(board_test_o(board,size)) return 'O';
 	return '+';
 }
-// simula ubn juego a partir de la pposicion
-static char game_sim(const char* board,int size,char player){
-	char bcopy[MAX_BOARD_SIZE];
-	for(int i=0;i<size*size;i++) bcopy[i]=board[i];
-	char turn=player;
-	char out;
-	uint64_t move;
-	int attempts=0;
-	int max_attempts=(size*size)*3;
-	while(attempts<max_attempts){
-		move=pcg32_boundedrand(size*size);
-		if(bcopy[move]!='+'){ attempts++; continue; }
-		bcopy[move]=turn;
-		out=board_test(bcopy,size);
-		if(out!='+') break;
-		turn=(turn=='X')?'O':'X';
-		attempts++;
-	}
-	return out;
-} 
-//Simula muchos juegos y obtiene estadisticas, luego decido donde jugar
-//Usa Monte Carlo Tree Search (MCTS) simple con distribución adaptativa
-void game_stats(const char* board,int size, char player, int nsim, int64_t* stat){
-	char base[MAX_BOARD_SIZE];
-	int moves[MAX_BOARD_SIZE];
-	int move_count=0;
+// Motor del proceso (el del juego y las herramientas); sus simulaciones siguen las
+// opciones de playout.c, que se copian al empezar cada busqueda
+static search_ctx_t process_search={
+	.engine=ENGINE_UCT,
+	.alloc=ALLOC_HALVING,
+	.threads=1,
+	.rave=1,
+	.prune=1,
+	.early_stop=1.0,
+	.tree_memory=MCTS_DEFAULT_MEMORY,
+	.tt_memory=MCTS_DEFAULT_TT_MEMORY,
+	.rng=PCG32_INITIALIZER
+};
+static search_ctx_t* process_ctx(void){
+	playout_get_options(&process_search.playout);
+	return &process_search;
+}
+// Valores por defecto de un motor nuevo; el arbol se reserva en su primera busqueda
+void search_ctx_init(search_ctx_t* ctx){
+	memset(ctx,0,sizeof(*ctx));
+	ctx->engine=ENGINE_UCT;
+	ctx->alloc=ALLOC_HALVING;
+	ctx->threads=1;
+	ctx->rave=1;
+	ctx->prune=1;
+	ctx->early_stop=1.0;
+	ctx->tree_memory=MCTS_DEFAULT_MEMORY;
+	ctx->tt_memory=MCTS_DEFAULT_TT_MEMORY;
+	ctx->playout.mode=PLAYOUT_FILL;
+	ctx->playout.policy=PLAYOUT_POLICY_AUTO;
+	playout_resolve_kernel(PLAYOUT_KERNEL_AUTO,&ctx->playout.kernel);
+	ctx->rng=(pcg32_random_t)PCG32_INITIALIZER;
+}
+void search_ctx_free(search_ctx_t* ctx){
+	if(ctx->tree.nodes) mcts_tree_free(&ctx->tree);
+}
+
+void game_seed(uint64_t initstate,uint64_t initseq){
+	pcg32_srandom_r(&process_search.rng,initstate,initseq);
+}
+// Hilos que comparten el arbol UCT en cada busqueda
+void game_set_threads(int threads){
+	process_search.threads=(threads<1)?1:threads;
+}
+
+// Estadisticas AMAF/RAVE en el arbol UCT (activas por defecto)
+void game_set_rave(int enabled){
+	process_search.rave=enabled;
+}
+
+// Descarta casillas muertas, capturadas o de puente propio antes de buscar
+void game_set_prune(int enabled){
+	process_search.prune=enabled;
+}
+
+// Parada temprana: se deja de buscar cuando la mejor jugada ya no puede ser alcanzada
+// con el presupuesto que queda multiplicado por 'factor' (1 exacto, 0 la desactiva)
+void game_set_early_stop(double factor){
+	process_search.early_stop=(factor<0.0)?0.0:factor;
+}
+// 1 si con 'left' simulaciones mas ninguna otra jugada puede alcanzar a la mejor.
+// Vale para cualquier motor: cada simulacion cambia en a lo mas 1 la estadistica de
+// un solo movimiento (visitas en UCT, victorias o diferencia en el motor plano).
+static int ctx_decided(const search_ctx_t* ctx,const int64_t* stats,int size,int64_t left){
+	if(ctx->early_stop<=0.0) return 0;
+	int64_t best=INT64_MIN, second=INT64_MIN;
 	for(int i=0;i<size*size;i++){
-		base[i]=board[i];
-		if(board[i]=='+'){
-			stat[i]=0;
-			moves[move_count++]=i;
-		}else{
-			stat[i]=INT64_MIN;
+		if(stats[i]==INT64_MIN) continue;
+		if(stats[i]>best){ second=best; best=stats[i]; }
+		else if(stats[i]>second) second=stats[i];
+	}
+	if(second==INT64_MIN) return best!=INT64_MIN;
+	return (double)(best-second) > ctx->early_stop*(double)left;
+}
+int game_decided(const int64_t* stats,int size,int64_t left){
+	return ctx_decided(&process_search,stats,size,left);
+}
+// Limita la raiz de las busquedas siguientes a 'moves' (NULL quita el limite). Lo usa
+// el juego para no buscar fuera de la zona que corta las amenazas del rival.
+void game_restrict_root(const bitset_t* moves){
+	process_search.restrict_root=(moves!=NULL);
+	if(moves) process_search.root_only=*moves;
+}
+// Reparto de las simulaciones entre los movimientos de la raiz del motor plano
+void game_set_alloc(alloc_t alloc){
+	process_search.alloc=alloc;
+}
+int game_parse_alloc(const char* name,alloc_t* alloc){
+	if(!name || !alloc) return 0;
+	if(strcmp(name,"twopass")==0){ *alloc=ALLOC_TWOPASS; return 1; }
+	if(strcmp(name,"halving")==0){ *alloc=ALLOC_HALVING; return 1; }
+	return 0;
+}
+void game_set_engine(engine_t engine){
+	process_search.engine=engine;
+}
+engine_t game_get_engine(void){
+	return process_search.engine;
+}
+int game_parse_engine(const char* name,engine_t* engine){
+	if(!name || !engine) return 0;
+	if(strcmp(name,"uct")==0){ *engine=ENGINE_UCT; return 1; }
+	if(strcmp(name,"flat")==0){ *engine=ENGINE_FLAT; return 1; }
+	return 0;
+}
+// Memoria de la arena del arbol; se aplica antes de la primera busqueda
+void game_set_tree_memory(size_t bytes){
+	process_search.tree_memory=bytes;
+}
+// Memoria de la tabla de transposiciones del arbol (0 la desactiva)
+void game_set_tt_memory(size_t bytes){
+	process_search.tt_memory=bytes;
+}
+// Plan del motor plano por fases. Cada fase asigna simulaciones a algunos movimientos
+// de la raiz; con los resultados se decide la siguiente. Lo usa flat_stats en un solo
+// proceso y el proceso principal para repartir cada fase entre sus trabajadores.
+//  ALLOC_TWOPASS: fase rapida pareja (al menos 10 por movimiento) y una segunda
+//                 proporcional al resultado; la estadistica es victorias - derrotas
+//  ALLOC_HALVING: ceil(log2 n) rondas; en cada una los supervivientes reciben la misma
+//                 parte y pasa la mitad con mejor tasa acumulada. La estadistica son
+//                 las victorias: como los supervivientes acumulan el doble de
+//                 simulaciones en cada ronda, el ultimo queda arriba aunque todos
+//                 pierdan mas de lo que ganan.
+static int plan_init(const search_ctx_t* ctx,flat_plan_t* plan,const char* board,int size,char player,int64_t nsim){
+	position_t p;
+	bitset_t candidates;
+	position_from_board(&p,board,size);
+	if(ctx->prune) inferior_filter(&p,size,player,&candidates);
+	else{
+		bs_board_mask(&candidates,size);
+		for(int w=0;w<BB_WORDS;w++) candidates.w[w]&=~(p.x.w[w]|p.o.w[w]);
+	}
+	// Como en la raiz del arbol: la restriccion se ignora si no deja ningun candidato
+	if(ctx->restrict_root){
+		bitset_t only;
+		int any=0;
+		for(int w=0;w<BB_WORDS;w++){
+			only.w[w]=candidates.w[w]&ctx->root_only.w[w];
+			any|=(only.w[w]!=0);
 		}
+		if(any) candidates=only;
+	}
+	plan->alloc=ctx->alloc;
+	plan->size=size;
+	plan->nsim=nsim;
+	plan->move_count=0;
+	plan->phase=0;
+	plan->done=0;
+	for(int i=0;i<size*size;i++){
+		plan->sims[i]=0;
+		plan->wins[i]=0;
+		if(bs_get(&candidates,i)) plan->moves[plan->move_count++]=i;
+	}
+	plan->alive=plan->move_count;
+	if(plan->alloc==ALLOC_HALVING){
+		plan->phases=0;
+		while((1<<plan->phases)<plan->move_count) plan->phases++;
+		if(plan->phases==0) plan->phases=1;
+	}else{
+		plan->phases=2;
+	}
+	if(plan->move_count==0 || nsim<=0) plan->phases=0;
+	return plan->move_count;
+}
+int flat_plan_init(flat_plan_t* plan,const char* board,int size,char player,int64_t nsim){
+	return plan_init(&process_search,plan,board,size,player,nsim);
+}
+// Simulaciones de la siguiente fase por casilla; regresa 0 cuando el plan termino
+int flat_plan_next(const flat_plan_t* plan,int64_t* counts){
+	int n=plan->move_count;
+	for(int i=0;i<plan->size*plan->size;i++) counts[i]=0;
+	if(plan->phase>=plan->phases) return 0;
+	if(plan->alloc==ALLOC_HALVING){
+		// La ultima ronda se lleva lo que sobre del presupuesto
+		int64_t share=(plan->phase==plan->phases-1)?(plan->nsim-plan->done)/plan->alive
+			:plan->nsim/((int64_t)plan->phases*plan->alive);
+		if(share<1) share=1;
+		for(int idx=0;idx<plan->alive;idx++) counts[plan->moves[idx]]=share;
+		return 1;
+	}
+	int64_t quick_sims=plan->nsim/(n*2);
+	if(quick_sims<10) quick_sims=10;
+	if(plan->phase==0){
+		for(int idx=0;idx<n;idx++) counts[plan->moves[idx]]=quick_sims;
+		return 1;
+	}
+	// Segunda pasada: asignar simulaciones restantes a movimientos prometedores (UCB-like)
+	int64_t total_sims=plan->nsim-quick_sims*n;
+	int64_t best_score=INT64_MIN;
+	for(int idx=0;idx<n;idx++){
+		int pos=plan->moves[idx];
+		int64_t score=2*plan->wins[pos]-plan->sims[pos];
+		if(score>best_score) best_score=score;
+	}
+	for(int idx=0;idx<n;idx++){
+		int pos=plan->moves[idx];
+		int64_t score=2*plan->wins[pos]-plan->sims[pos];
+		int64_t extra_sims;
+		if(best_score>0) extra_sims=(score+best_score+1)*total_sims/(n*(best_score*2+1));
+		else extra_sims=total_sims/n;
+		counts[pos]=(extra_sims>0)?extra_sims:0;
+	}
+	return 1;
+}
+// Suma los resultados de una fase (victorias de quien mueve) y prepara la siguiente
+void flat_plan_record(flat_plan_t* plan,const int64_t* counts,const int64_t* wins){
+	for(int idx=0;idx<plan->move_count;idx++){
+		int pos=plan->moves[idx];
+		plan->sims[pos]+=counts[pos];
+		plan->wins[pos]+=wins[pos];
+		plan->done+=counts[pos];
 	}
-	if(move_count==0 || nsim<=0) return;
-	
-	char other =(player=='X')?'O':'X';
-	
-	// Primera pasada: evaluación rápida de todos los movimientos
-	int quick_sims = nsim / (move_count * 2);
-	if(quick_sims < 10) quick_sims = 10;
-	
-	int64_t quick_results[MAX_BOARD_SIZE];
-	for(int i=0;i<size*size;i++) quick_results[i]=0;
-	
-	for(int idx=0; idx<move_count; idx++){
-		int pos = moves[idx];
-		for(int r=0; r<quick_sims; r++){
-			base[pos]=player;
-			char out=game_sim(base,size,other);
-			base[pos]='+';
-			if(out==player) quick_results[pos]++;
-			else quick_results[pos]--;
+	if(plan->alloc==ALLOC_HALVING){
+		// Ordena por tasa de victorias (insercion; a lo mas MAX_BOARD_SIZE movimientos)
+		int* moves=plan->moves;
+		for(int i=1;i<plan->alive;i++){
+			int pos=moves[i];
+			int j=i;
+			while(j>0 && plan->wins[pos]*plan->sims[moves[j-1]] > plan->wins[moves[j-1]]*plan->sims[pos]){
+				moves[j]=moves[j-1];
+				j--;
+			}
+			moves[j]=pos;
 		}
+		plan->alive=(plan->alive+1)/2;
+	}
+	plan->phase++;
+}
+// Estadisticas compatibles con game_move; regresa las simulaciones hechas
+int64_t flat_plan_stats(const flat_plan_t* plan,int64_t* stat){
+	for(int i=0;i<plan->size*plan->size;i++) stat[i]=INT64_MIN;
+	for(int idx=0;idx<plan->move_count;idx++){
+		int pos=plan->moves[idx];
+		if(plan->alloc==ALLOC_HALVING) stat[pos]=plan->wins[pos];
+		else stat[pos]=2*plan->wins[pos]-plan->sims[pos];
+	}
+	return plan->done;
+}
+// Simula counts[i] partidas tras cada jugada i de 'player' y deja en wins[i] cuantas
+// gana 'player'. Regresa el total de simulaciones.
+static int64_t ctx_eval(search_ctx_t* ctx,const char* board,int size,char player,const int64_t* counts,int64_t* wins){
+	position_t p;
+	playout_root_t base;
+	char other=(player=='X')?'O':'X';
+	int64_t done=0;
+	position_from_board(&p,board,size);
+	playout_prepare(&base,&p,size,&ctx->playout);
+	for(int pos=0;pos<size*size;pos++){
+		wins[pos]=0;
+		if(counts[pos]<=0 || board[pos]!='+') continue;
+		playout_root_t child=base;
+		playout_play(&child,pos,player);
+		int lost=playout_run_batch(&child,other,(int)counts[pos],&ctx->rng);
+		wins[pos]=counts[pos]-lost;
+		done+=counts[pos];
 	}
-	
-	// Segunda pasada: asignar simulaciones restantes a movimientos prometedores
-	int64_t total_sims = nsim - (quick_sims * move_count);
-	int64_t best_score = INT64_MIN;
-	for(int i=0; i<move_count; i++) best_score = (quick_results[moves[i]] > best_score) ? quick_results[moves[i]] : best_score;
-	
-	for(int idx=0; idx<move_count; idx++){
-		int pos = moves[idx];
-		int64_t score = quick_results[pos];
-		
-		// Asignar más simulaciones a movimientos mejores (UCB-like)
-		int extra_sims = 0;
-		if(best_score > 0){
-			extra_sims = (int)((score + best_score + 1) * total_sims / (move_count * (best_score * 2 + 1)));
-		}else{
-			extra_sims = (int)(total_sims / move_count);
+	return done;
+}
+int64_t game_eval(const char* board,int size,char player,const int64_t* counts,int64_t* wins){
+	return ctx_eval(process_ctx(),board,size,player,counts,wins);
+}
+//Simula muchos juegos y obtiene estadisticas, luego decido donde jugar
+//Monte Carlo plano sobre los movimientos de la raiz con distribución adaptativa
+// Con 'stopped' revisa la parada temprana entre fases y deja ahi si se detuvo; las
+// rondas de flat_timed pasan NULL porque la revisan sobre la suma de todas
+static int64_t flat_stats(search_ctx_t* ctx,const char* board,int size, char player, int nsim, int64_t* stat,int* stopped){
+	flat_plan_t plan;
+	int64_t counts[MAX_BOARD_SIZE];
+	int64_t wins[MAX_BOARD_SIZE];
+	plan_init(ctx,&plan,board,size,player,nsim);
+	if(stopped) *stopped=0;
+	while(flat_plan_next(&plan,counts)){
+		ctx_eval(ctx,board,size,player,counts,wins);
+		flat_plan_record(&plan,counts,wins);
+		if(stopped){
+			flat_plan_stats(&plan,stat);
+			if(plan.phase<plan.phases && ctx_decided(ctx,stat,size,plan.nsim-plan.done)){
+				*stopped=1;
+				break;
+			}
 		}
-		
-		for(int r=0; r<extra_sims; r++){
-			base[pos]=player;
-			char out=game_sim(base,size,other);
-			base[pos]='+';
-			if(out==player) stat[pos]++;
-			else stat[pos]--;
+	}
+	return flat_plan_stats(&plan,stat);
+}
+double clock_ms(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC,&ts);
+	return (double)ts.tv_sec*1000.0+(double)ts.tv_nsec/1e6;
+}
+// En modo plano con tiempo se repiten rondas de este numero de simulaciones por movimiento
+#define FLAT_ROUND_PER_MOVE 32
+
+static int budget_open(const search_budget_t* budget,int64_t done,double deadline){
+	if(budget->nsim>0 && done>=budget->nsim) return 0;
+	return clock_ms()<deadline;
+}
+// Monte Carlo plano con tiempo: rondas completas de flat_stats acumuladas
+static int64_t flat_timed(search_ctx_t* ctx,const char* board,int size, char player, const search_budget_t* budget, int64_t* stat,int* stopped){
+	int64_t round[MAX_BOARD_SIZE];
+	int empty=0;
+	for(int i=0;i<size*size;i++) if(board[i]=='+') empty++;
+	int chunk=(empty>0?empty:1)*FLAT_ROUND_PER_MOVE;
+	double deadline=clock_ms()+(double)budget->time_ms;
+	double started=clock_ms();
+	int64_t done=flat_stats(ctx,board,size,player,chunk,stat,NULL);
+	*stopped=0;
+	while(budget_open(budget,done,deadline)){
+		// Lo que falta se estima con el ritmo que lleva la busqueda
+		double now=clock_ms();
+		int64_t left=(int64_t)((double)done/(now-started+1e-3)*(deadline-now))+1;
+		if(budget->nsim>0 && budget->nsim-done<left) left=budget->nsim-done;
+		if(ctx_decided(ctx,stat,size,left)){
+			*stopped=1;
+			break;
 		}
-		stat[pos] += quick_results[pos];
+		done+=flat_stats(ctx,board,size,player,chunk,round,NULL);
+		for(int i=0;i<size*size;i++) if(stat[i]!=INT64_MIN) stat[i]+=round[i];
 	}
+	return done;
+}
+static int64_t flat_search(search_ctx_t* ctx,const char* board,int size, char player, const search_budget_t* budget, int64_t* stat){
+	if(budget->time_ms>0) return flat_timed(ctx,board,size,player,budget,stat,&ctx->stopped);
+	return flat_stats(ctx,board,size,player,(int)budget->nsim,stat,&ctx->stopped);
+}
+// Simulaciones del arbol UCT. Con la politica AUTO usa puentes: el arbol simula una
+// partida por hoja y cada una vale mas que su costo; el motor plano se queda al azar
+// para aprovechar el nucleo vectorial de los lotes.
+static void tree_playout(search_ctx_t* ctx){
+	ctx->tree.playout=ctx->playout;
+	if(ctx->tree.playout.policy==PLAYOUT_POLICY_AUTO) ctx->tree.playout.policy=PLAYOUT_POLICY_BRIDGE;
+}
+// Busqueda UCT: las estadisticas son las visitas de cada movimiento de la raiz.
+// El arbol persiste entre llamadas y se reutiliza el subarbol de la posicion nueva.
+static int64_t uct_stats(search_ctx_t* ctx,const char* board,int size, char player, const search_budget_t* budget, int64_t* stat){
+	mcts_tree_t* tree=&ctx->tree;
+	if(!tree->nodes && mcts_tree_init(tree,ctx->tree_memory,ctx->tt_memory)!=0){
+		return flat_search(ctx,board,size,player,budget,stat);
+	}
+	tree->rave=ctx->rave;
+	tree->prune=ctx->prune;
+	tree->early_stop=ctx->early_stop;
+	tree->restrict_root=ctx->restrict_root;
+	tree->root_only=ctx->root_only;
+	tree_playout(ctx);
+	mcts_set_root(tree,board,size,player);
+	int64_t done=mcts_run(tree,budget,ctx->threads,&ctx->rng,&ctx->stopped);
+	mcts_root_stats(tree,stat);
+	return done;
+}
+// Busca con un presupuesto de simulaciones y/o tiempo. Regresa las simulaciones hechas.
+int64_t search_ctx_run(search_ctx_t* ctx,const char* board,int size, char player, const search_budget_t* budget, int64_t* stat){
+	if(ctx->engine==ENGINE_UCT) return uct_stats(ctx,board,size,player,budget,stat);
+	return flat_search(ctx,board,size,player,budget,stat);
+}
+int64_t game_search(const char* board,int size, char player, const search_budget_t* budget, int64_t* stat){
+	return search_ctx_run(process_ctx(),board,size,player,budget,stat);
+}
+void game_stats(const char* board,int size, char player, int nsim, int64_t* stat){
+	search_budget_t budget={nsim,0};
+	game_search(board,size,player,&budget,stat);
+}
+// 1 si la ultima game_search termino por la parada temprana y no por agotar el presupuesto
+int game_search_stopped(void){
+	return process_search.stopped;
+}
+// 1 si repetir game_search sobre la misma posicion devuelve estadisticas acumuladas
+// (el arbol UCT conserva sus visitas); 0 si cada llamada es independiente (plano)
+int game_search_cumulative(void){
+	return process_search.engine==ENGINE_UCT && process_search.tree.nodes!=NULL;
+}
+// Sigue buscando en la posicion sin producir estadisticas (meditacion durante el
+// turno del rival); lo aprendido se reutiliza cuando llega su jugada.
+// Regresa 0 si no hay trabajo util: motor plano o arena llena.
+int game_ponder(const char* board,int size, char player, int nsim){
+	search_ctx_t* ctx=process_ctx();
+	mcts_tree_t* tree=&ctx->tree;
+	if(ctx->engine!=ENGINE_UCT) return 0;
+	if(!tree->nodes && mcts_tree_init(tree,ctx->tree_memory,ctx->tt_memory)!=0) return 0;
+	tree->rave=ctx->rave;
+	tree->prune=ctx->prune;
+	tree->early_stop=ctx->early_stop;
+	// La posicion del rival no tiene zona obligada calculada
+	tree->restrict_root=0;
+	tree_playout(ctx);
+	mcts_set_root(tree,board,size,player);
+	if(mcts_full(tree)) return 0;
+	mcts_search(tree,nsim,&ctx->rng);
+	return 1;
 }
 int game_move(int64_t* stats,int size){
 	int move=-1;
@@ -16,6 +16,42 @@ typedef enum {
 	black
 } token_t;
 
+typedef enum {
+	ENGINE_UCT,
+	ENGINE_FLAT
+} engine_t;
+
+// Reparto del presupuesto del motor plano entre los movimientos de la raiz:
+//  ALLOC_TWOPASS: pasada rapida pareja y una segunda proporcional al resultado
+//  ALLOC_HALVING: halving secuencial (se descarta la peor mitad en cada ronda)
+typedef enum {
+	ALLOC_TWOPASS,
+	ALLOC_HALVING
+} alloc_t;
+
+// Presupuesto de una busqueda. Con time_ms > 0 se simula en lotes hasta agotar el
+// tiempo; nsim sigue siendo un tope si es positivo.
+typedef struct {
+	int64_t nsim;
+	int64_t time_ms;
+} search_budget_t;
+
+// Plan por fases del motor plano (ver flat_plan_init en hex.c). Las casillas se
+// indexan como el tablero; moves guarda los candidatos (los supervivientes primero).
+typedef struct {
+	alloc_t alloc;
+	int size;
+	int64_t nsim;
+	int move_count;
+	int alive;
+	int phase;
+	int phases;
+	int64_t done;
+	int moves[MAX_BOARD_SIZE];
+	int64_t sims[MAX_BOARD_SIZE];
+	int64_t wins[MAX_BOARD_SIZE];
+} flat_plan_t;
+
 typedef enum {
 	TL,
 	TR,
@@ -28,14 +64,39 @@ typedef enum {
 void board_print(const char * board,int size);
 void board_clear(char * board,int size);
 int place_token(char * board,int size,int pos,char player);
+int place_token_hash(char * board,int size,int pos,char player,uint64_t* hash);
+uint64_t board_hash(const char * board,int size);
 token_t board_status(const char * board,int size);
 int to_ind(int size,int x,int y);
 void to_xy(int size, int ind,int* x,int* y);
 void game_stats(const char* board,int size, char player, int nsim, int64_t* stat);
+int64_t game_search(const char* board,int size, char player, const search_budget_t* budget, int64_t* stat);
+int game_search_cumulative(void);
+int game_search_stopped(void);
+int game_ponder(const char* board,int size, char player, int nsim);
+void game_set_engine(engine_t engine);
+engine_t game_get_engine(void);
+void game_set_threads(int threads);
+void game_set_rave(int enabled);
+void game_set_prune(int enabled);
+void game_set_alloc(alloc_t alloc);
+void game_set_early_stop(double factor);
+int game_decided(const int64_t* stats,int size,int64_t left);
+int flat_plan_init(flat_plan_t* plan,const char* board,int size,char player,int64_t nsim);
+int flat_plan_next(const flat_plan_t* plan,int64_t* counts);
+void flat_plan_record(flat_plan_t* plan,const int64_t* counts,const int64_t* wins);
+int64_t flat_plan_stats(const flat_plan_t* plan,int64_t* stat);
+int64_t game_eval(const char* board,int size,char player,const int64_t* counts,int64_t* wins);
+int game_parse_alloc(const char* name,alloc_t* alloc);
+void game_seed(uint64_t initstate,uint64_t initseq);
+int game_parse_engine(const char* name,engine_t* engine);
+void game_set_tree_memory(size_t bytes);
+void game_set_tt_memory(size_t bytes);
 int board_test_x(const char * board,int size);
 int board_test_o(const char * board,int size);
 char board_test(const char* board,int size);
 int game_move(int64_t* stats,int size);
 int read_move(const char* buffer,int size);
 void trim(char * str);
+double clock_ms(void);
 #endif 
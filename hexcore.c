@@ -0,0 +1,149 @@
+#include <stdlib.h>
+#include <string.h>
+#include "hexcore.h"
+#include "search.h"
+
+struct hexcore {
+	search_ctx_t search;
+	search_budget_t budget;
+	int size;
+	char player;
+	char board[MAX_BOARD_SIZE];
+	int searched;
+	int64_t stats[MAX_BOARD_SIZE];
+};
+
+hexcore_t *hexcore_create(int size, int64_t nsim, int64_t time_ms, int threads) {
+	if (size < 2 || size > HEXCORE_MAX_SIDE || threads < 1 || threads > MAX_PROC) return NULL;
+	hexcore_t *core = malloc(sizeof(*core));
+	if (!core) return NULL;
+	search_ctx_init(&core->search);
+	core->search.threads = threads;
+	core->size = size;
+	if (hexcore_set_budget(core, nsim, time_ms) != 0) {
+		free(core);
+		return NULL;
+	}
+	board_clear(core->board, size);
+	core->player = 'X';
+	core->searched = 0;
+	return core;
+}
+
+void hexcore_destroy(hexcore_t *core) {
+	if (!core) return;
+	search_ctx_free(&core->search);
+	free(core);
+}
+
+static int parse_flag(const char *value, int *flag) {
+	if (strcmp(value, "1") == 0) *flag = 1;
+	else if (strcmp(value, "0") == 0) *flag = 0;
+	else return 0;
+	return 1;
+}
+
+static int parse_mb(const char *value, long min, size_t *bytes) {
+	char *end = NULL;
+	long mb = strtol(value, &end, 10);
+	if (end == value || *end != '\0' || mb < min || mb > 65536) return 0;
+	*bytes = (size_t)mb << 20;
+	return 1;
+}
+
+int hexcore_set_option(hexcore_t *core, const char *name, const char *value) {
+	if (!core || !name || !value) return -1;
+	search_ctx_t *ctx = &core->search;
+	int ok;
+	if (strcmp(name, "engine") == 0) {
+		ok = game_parse_engine(value, &ctx->engine);
+	} else if (strcmp(name, "alloc") == 0) {
+		ok = game_parse_alloc(value, &ctx->alloc);
+	} else if (strcmp(name, "playout") == 0) {
+		ok = playout_parse_mode(value, &ctx->playout.mode);
+	} else if (strcmp(name, "playout-policy") == 0) {
+		ok = playout_parse_policy(value, &ctx->playout.policy);
+	} else if (strcmp(name, "simd") == 0) {
+		playout_kernel_t kernel;
+		ok = playout_parse_kernel(value, &kernel) && playout_resolve_kernel(kernel, &ctx->playout.kernel);
+	} else if (strcmp(name, "rave") == 0) {
+		ok = parse_flag(value, &ctx->rave);
+	} else if (strcmp(name, "prune") == 0) {
+		ok = parse_flag(value, &ctx->prune);
+	} else if (strcmp(name, "early-stop") == 0) {
+		char *end = NULL;
+		double factor = strtod(value, &end);
+		ok = end != value && *end == '\0' && factor >= 0.0;
+		if (ok) ctx->early_stop = factor;
+	} else if (strcmp(name, "threads") == 0) {
+		int threads = atoi(value);
+		ok = threads >= 1 && threads <= MAX_PROC;
+		if (ok) ctx->threads = threads;
+	} else if (strcmp(name, "tree-mb") == 0 || strcmp(name, "tt-mb") == 0) {
+		int tree = strcmp(name, "tree-mb") == 0;
+		ok = parse_mb(value, tree ? 1 : 0, tree ? &ctx->tree_memory : &ctx->tt_memory);
+		// La memoria se aplica al reservar el arbol: se libera y la siguiente busqueda
+		// lo crea con el tamano nuevo
+		if (ok) search_ctx_free(ctx);
+	} else {
+		ok = 0;
+	}
+	return ok ? 0 : -1;
+}
+
+int hexcore_set_budget(hexcore_t *core, int64_t nsim, int64_t time_ms) {
+	if (!core || nsim < 0 || time_ms < 0 || (nsim == 0 && time_ms == 0) || nsim > INT32_MAX) return -1;
+	core->budget.nsim = nsim;
+	core->budget.time_ms = time_ms;
+	return 0;
+}
+
+void hexcore_seed(hexcore_t *core, uint64_t initstate, uint64_t initseq) {
+	if (core) pcg32_srandom_r(&core->search.rng, initstate, initseq);
+}
+
+int hexcore_set_position(hexcore_t *core, const char *board, char player) {
+	if (!core || !board || (player != 'X' && player != 'O')) return -1;
+	for (int i = 0; i < core->size * core->size; i++) {
+		if (board[i] != 'X' && board[i] != 'O' && board[i] != '+') return -1;
+	}
+	memcpy(core->board, board, (size_t)(core->size * core->size));
+	core->player = player;
+	core->searched = 0;
+	return 0;
+}
+
+int hexcore_play(hexcore_t *core, int cell) {
+	if (!core || cell < 0 || cell >= core->size * core->size) return -1;
+	if (core->board[cell] != '+' || board_test(core->board, core->size) != '+') return -1;
+	core->board[cell] = core->player;
+	core->player = (core->player == 'X') ? 'O' : 'X';
+	core->searched = 0;
+	return 0;
+}
+
+char hexcore_winner(const hexcore_t *core) {
+	if (!core) return '+';
+	return board_test(core->board, core->size);
+}
+
+int64_t hexcore_search(hexcore_t *core) {
+	if (!core || board_test(core->board, core->size) != '+') return -1;
+	if (!memchr(core->board, '+', (size_t)(core->size * core->size))) return -1;
+	int64_t done = search_ctx_run(&core->search, core->board, core->size, core->player, &core->budget, core->stats);
+	core->searched = 1;
+	return done;
+}
+
+int hexcore_stats(const hexcore_t *core, int64_t *stats) {
+	if (!core || !stats || !core->searched) return -1;
+	memcpy(stats, core->stats, (size_t)(core->size * core->size) * sizeof(stats[0]));
+	return 0;
+}
+
+int hexcore_best_move(const hexcore_t *core) {
+	if (!core || !core->searched) return -1;
+	int64_t stats[MAX_BOARD_SIZE];
+	memcpy(stats, core->stats, (size_t)(core->size * core->size) * sizeof(stats[0]));
+	return game_move(stats, core->size);
+}
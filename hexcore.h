@@ -0,0 +1,49 @@
+#ifndef HEXCORE_H
+#define HEXCORE_H
+
+#include <stdint.h>
+
+// libhexcore: el motor de Hex sin interfaz ni estado global. Cada hexcore_t es un motor
+// independiente (opciones, arbol UCT y generador propios): varios pueden buscar a la
+// vez en un proceso, cada uno desde su hilo. Un mismo motor no se usa desde dos hilos.
+//
+// El tablero son size*size caracteres 'X', 'O' o '+' (vacia) con la casilla (x, y) en
+// y*size+x. X une las columnas 0 y size-1; O las filas 0 y size-1.
+// Las funciones que pueden fallar regresan 0 (o un valor no negativo) si todo va bien
+// y -1 si no.
+
+#define HEXCORE_MAX_SIDE 26
+
+typedef struct hexcore hexcore_t;
+
+// Motor para tableros de lado 'size' (2 a HEXCORE_MAX_SIDE), tablero vacio y X en turno.
+// El presupuesto de cada busqueda es nsim simulaciones y/o time_ms milisegundos (al
+// menos uno positivo); 'threads' hilos comparten el arbol UCT. NULL si falla.
+hexcore_t *hexcore_create(int size, int64_t nsim, int64_t time_ms, int threads);
+void hexcore_destroy(hexcore_t *core);
+
+// Opciones con los nombres y valores de las banderas del juego:
+//  engine uct|flat, alloc halving|twopass, playout fill|incremental,
+//  playout-policy auto|bridge|random, simd auto|avx2|sse2|scalar, rave 0|1, prune 0|1,
+//  early-stop F, tree-mb N, tt-mb N, threads N
+int hexcore_set_option(hexcore_t *core, const char *name, const char *value);
+int hexcore_set_budget(hexcore_t *core, int64_t nsim, int64_t time_ms);
+void hexcore_seed(hexcore_t *core, uint64_t initstate, uint64_t initseq);
+
+// Posicion a analizar y jugador en turno ('X' u 'O')
+int hexcore_set_position(hexcore_t *core, const char *board, char player);
+// Juega 'cell' con el jugador en turno y pasa el turno
+int hexcore_play(hexcore_t *core, int cell);
+// 'X' u 'O' si la posicion ya tiene ganador, '+' si no
+char hexcore_winner(const hexcore_t *core);
+
+// Busca en la posicion actual y regresa las simulaciones hechas. Con el motor uct el
+// arbol se conserva: si la posicion siguiente desciende de esta, se reutiliza.
+int64_t hexcore_search(hexcore_t *core);
+// Copia las estadisticas de la ultima busqueda (size*size valores; INT64_MIN en las
+// casillas que no son candidatas): visitas con uct, victorias o diferencia con flat
+int hexcore_stats(const hexcore_t *core, int64_t *stats);
+// Mejor casilla de la ultima busqueda
+int hexcore_best_move(const hexcore_t *core);
+
+#endif
@@ -0,0 +1,130 @@
+#include "inferior.h"
+
+// Vecinos en orden circular: cada uno es vecino del siguiente
+static const int ring_dx[6] = {1, 0, -1, -1, 0, 1};
+static const int ring_dy[6] = {0, 1, 1, 0, -1, -1};
+
+// Contenido de los seis vecinos; fuera del tablero cuenta el lado del jugador que lo
+// posee (filas para O, columnas para X). Regresa 0 en las esquinas agudas, donde un
+// vecino quedaria fuera por ambos lados.
+static int ring_of(const position_t *p, int size, int pos, char ring[6]) {
+	int x = pos % size;
+	int y = pos / size;
+	for (int i = 0; i < 6; i++) {
+		int nx = x + ring_dx[i];
+		int ny = y + ring_dy[i];
+		int out_x = (nx < 0 || nx >= size);
+		int out_y = (ny < 0 || ny >= size);
+		if (out_x && out_y) return 0;
+		if (out_y) ring[i] = 'O';
+		else if (out_x) ring[i] = 'X';
+		else ring[i] = position_cell(p, ny * size + nx);
+	}
+	return 1;
+}
+
+static int runs_of(const char ring[6], char player) {
+	int runs = 0;
+	int all = 1;
+	for (int i = 0; i < 6; i++) {
+		if (ring[i] != player) all = 0;
+		else if (ring[(i + 5) % 6] != player) runs++;
+	}
+	return all ? 1 : runs;
+}
+
+// Muerta si en toda forma de llenar los vecinos vacios cada color forma a lo mas un
+// arco: la ficha del centro nunca une dos grupos que los vecinos no unan ya
+static int ring_dead(const char ring[6]) {
+	int empty[6];
+	int count = 0;
+	for (int i = 0; i < 6; i++) {
+		if (ring[i] == '+') empty[count++] = i;
+	}
+	char fill[6];
+	for (int mask = 0; mask < (1 << count); mask++) {
+		for (int i = 0; i < 6; i++) fill[i] = ring[i];
+		for (int k = 0; k < count; k++) fill[empty[k]] = ((mask >> k) & 1) ? 'X' : 'O';
+		if (runs_of(fill, 'X') > 1 || runs_of(fill, 'O') > 1) return 0;
+	}
+	return 1;
+}
+
+static int cell_dead(const position_t *p, int size, int pos) {
+	char ring[6];
+	return ring_of(p, size, pos, ring) && ring_dead(ring);
+}
+
+// {a, b} capturado por 'player': con su ficha en cualquiera de los dos, el otro muere
+static int pair_captured(const position_t *p, int size, int a, int b, char player) {
+	position_t t = *p;
+	position_set(&t, a, player);
+	if (!cell_dead(&t, size, b)) return 0;
+	t = *p;
+	position_set(&t, b, player);
+	return cell_dead(&t, size, a);
+}
+
+// Hueco de un puente de 'player' (o de un puente al lado propio): en el anillo aparecen
+// ficha propia, el otro hueco vacio, ficha propia; el resto debe ser del rival
+static int bridge_dominated(const position_t *p, int size, int pos, char player) {
+	char ring[6];
+	char rival = (player == 'X') ? 'O' : 'X';
+	if (!ring_of(p, size, pos, ring)) return 0;
+	for (int i = 0; i < 6; i++) {
+		if (ring[i] != player || ring[(i + 1) % 6] != '+' || ring[(i + 2) % 6] != player) continue;
+		int rest = 1;
+		for (int k = 3; k < 6; k++) {
+			if (ring[(i + k) % 6] != rival) rest = 0;
+		}
+		if (rest) return 1;
+	}
+	return 0;
+}
+
+int inferior_filter(const position_t *p, int size, char player, bitset_t *moves) {
+	position_t filled = *p;
+	bitset_t empty;
+	int cells = size * size;
+	bs_board_mask(&empty, size);
+	for (int w = 0; w < BB_WORDS; w++) empty.w[w] &= ~(p->x.w[w] | p->o.w[w]);
+	// Los pares capturados se rellenan con su dueno; dos pasadas dejan ver capturas
+	// que aparecen al rellenar otras
+	for (int pass = 0; pass < 2; pass++) {
+		for (int a = 0; a < cells; a++) {
+			if (!position_empty(&filled, a)) continue;
+			int x = a % size;
+			int y = a / size;
+			for (int i = 0; i < 3; i++) {
+				int nx = x + ring_dx[i];
+				int ny = y + ring_dy[i];
+				if (nx < 0 || nx >= size || ny >= size) continue;
+				int b = ny * size + nx;
+				if (!position_empty(&filled, a) || !position_empty(&filled, b)) continue;
+				for (int c = 0; c < 2; c++) {
+					char owner = c ? 'O' : 'X';
+					if (pair_captured(&filled, size, a, b, owner)) {
+						position_set(&filled, a, owner);
+						position_set(&filled, b, owner);
+						break;
+					}
+				}
+			}
+		}
+	}
+	int count = 0;
+	bs_clear(moves);
+	for (int pos = 0; pos < cells; pos++) {
+		if (!bs_get(&empty, pos)) continue;
+		if (!position_empty(&filled, pos)) continue;
+		if (cell_dead(&filled, size, pos)) continue;
+		if (bridge_dominated(&filled, size, pos, player)) continue;
+		bs_set(moves, pos);
+		count++;
+	}
+	if (count == 0) {
+		*moves = empty;
+		for (int w = 0; w < BB_WORDS; w++) count += __builtin_popcountll(empty.w[w]);
+	}
+	return count;
+}
@@ -0,0 +1,16 @@
+#ifndef INFERIOR_H
+#define INFERIOR_H
+
+#include "bitboard.h"
+
+// Analisis de casillas inferiores con patrones locales sobre los seis vecinos:
+//  muertas: su color no cambia ninguna conexion, se llene como se llene el resto
+//  capturadas: pares que un jugador se queda sin costo (si el rival entra en una,
+//              la otra queda muerta); se tratan como fichas de ese jugador
+//  de puente propio: hueco de un puente de quien mueve que solo toca el puente y
+//              fichas rivales; jugarlo solo rellena una conexion ya segura
+// Regresa el numero de casillas en 'moves' (las que vale la pena jugar). Si todo
+// resulta inferior deja todas las vacias.
+int inferior_filter(const position_t *p, int size, char player, bitset_t *moves);
+
+#endif
@@ -8,8 +8,16 @@
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <signal.h>
+#include <poll.h>
+#include <sched.h>
+#include <sys/mman.h>
 
 #include "hex.h"
+#include "search.h"
+#include "playout.h"
+#include "protocol.h"
+#include "book.h"
+#include "vc.h"
 #include "ui.h"
 
 #define BUFLEN 128
@@ -18,6 +26,14 @@
 #define MIN_BOARD_SIZE 7
 #define MIN_SIMULATIONS 100
 #define MAX_SIMULATIONS 1000000
+#define PONDER_BATCH 256
+#define MIN_MOVE_TIME_MS 10
+// Reparto dinamico: lotes por trabajador, tamano minimo de lote y lotes en vuelo
+#define BATCHES_PER_WORKER 8
+#define MIN_BATCH 64
+#define MAX_INFLIGHT 2
+// Intentos de leer una ranura compartida que se esta escribiendo antes de darla por vacia
+#define SLOT_RETRIES 100000
 
 typedef struct {
 	int to_child[2];
@@ -25,23 +41,36 @@ typedef struct {
 	pid_t pid;
 } worker_t;
 
+// Ranura de resultados de un trabajador en la region compartida. Alineada a linea
+// de cache para que dos trabajadores nunca escriban en la misma linea. 'seq' es un
+// seqlock: impar mientras el trabajador escribe, asi el padre puede leer resultados
+// parciales en cualquier momento sin bloquearlo.
 typedef struct {
-	int cmd;
-	int size;
-	int nsim;
-	char player;
-	char board[MAX_BOARD_SIZE];
-} worker_request_t;
-
-typedef struct {
-	int cmd;
-	int size;
+	uint32_t seq;
+	int job;
+	int64_t playouts;
 	int64_t stats[MAX_BOARD_SIZE];
-} worker_response_t;
+} __attribute__((aligned(64))) result_slot_t;
+
+typedef enum {
+	IPC_PIPE,
+	IPC_SHM
+} ipc_mode_t;
 
 static worker_t workers[MAX_PROC];
 static int worker_count = 0;
 static int gui_enabled = 0;
+static int ponder_enabled = 0;
+static int use_threads = 0;
+static int job_counter = 0;
+static book_t opening_book;
+static int vc_enabled = 1;
+static int seed_fixed = 0;
+static uint64_t master_seed = 0;
+static ipc_mode_t ipc_mode = IPC_PIPE;
+static result_slot_t *result_slots = NULL;
+static size_t result_slots_len = 0;
+static int64_t worker_stats[MAX_PROC][MAX_BOARD_SIZE];
 static char status_line[256];
 static volatile int shutdown_requested = 0;
 
@@ -52,22 +81,135 @@ static void signal_handler(int sig) {
 
 static int board_has_free(const char * board,int size);
 static int determine_default_workers(void);
-static ssize_t read_full(int fd, void *buf, size_t count);
-static ssize_t write_full(int fd, const void *buf, size_t count);
-static void worker_loop(int read_fd, int write_fd);
+static void worker_loop(int index, int read_fd, int write_fd);
 static int spawn_workers(int count);
 static void stop_workers(void);
-static int parallel_stats(const char *board,int size,char player,int total_sims,int64_t *stats);
+static int parallel_stats(const char *board,int size,char player,const bitset_t *root_only,const search_budget_t *budget,int64_t *stats,int64_t *playouts,int *stopped);
+static void start_pondering(const char *board,int size,char player,int total_sims);
 static int get_line(const char *prompt, char *buffer, size_t len);
+static long parse_duration_ms(const char *text);
+static int64_t move_time_budget(int64_t clock_left, int free_cells, int64_t movetime);
 static void announce_board(const char *board, int size);
 
 int main(int argc, char **argv) {
 	int use_gui = 1;
+	int64_t movetime_ms = 0;
+	int64_t gametime_ms = 0;
 	for (int i = 1; i < argc; i++) {
 		if (strcmp(argv[i], "--no-gui") == 0) {
 			use_gui = 0;
 		} else if (strcmp(argv[i], "--gui") == 0) {
 			use_gui = 1;
+		} else if (strcmp(argv[i], "--playout") == 0 && i + 1 < argc) {
+			playout_mode_t mode;
+			if (!playout_parse_mode(argv[++i], &mode)) {
+				fprintf(stderr, "Modo de simulacion desconocido: %s (usa fill o incremental).\n", argv[i]);
+				return 1;
+			}
+			playout_set_mode(mode);
+		} else if (strcmp(argv[i], "--playout-policy") == 0 && i + 1 < argc) {
+			playout_policy_t policy;
+			if (!playout_parse_policy(argv[++i], &policy)) {
+				fprintf(stderr, "Politica de simulacion desconocida: %s (usa auto, bridge o random).\n", argv[i]);
+				return 1;
+			}
+			playout_set_policy(policy);
+		} else if (strcmp(argv[i], "--simd") == 0 && i + 1 < argc) {
+			playout_kernel_t kernel;
+			if (!playout_parse_kernel(argv[++i], &kernel)) {
+				fprintf(stderr, "Nucleo de simulacion desconocido: %s (usa auto, avx2, sse2 o scalar).\n", argv[i]);
+				return 1;
+			}
+			if (!playout_set_kernel(kernel)) {
+				fprintf(stderr, "Esta CPU no soporta el nucleo %s.\n", argv[i]);
+				return 1;
+			}
+		} else if (strcmp(argv[i], "--alloc") == 0 && i + 1 < argc) {
+			alloc_t alloc;
+			if (!game_parse_alloc(argv[++i], &alloc)) {
+				fprintf(stderr, "Reparto desconocido: %s (usa halving o twopass).\n", argv[i]);
+				return 1;
+			}
+			game_set_alloc(alloc);
+		} else if (strcmp(argv[i], "--engine") == 0 && i + 1 < argc) {
+			engine_t engine;
+			if (!game_parse_engine(argv[++i], &engine)) {
+				fprintf(stderr, "Motor desconocido: %s (usa uct o flat).\n", argv[i]);
+				return 1;
+			}
+			game_set_engine(engine);
+		} else if (strcmp(argv[i], "--tree-mb") == 0 && i + 1 < argc) {
+			long mb = strtol(argv[++i], NULL, 10);
+			if (mb < 1 || mb > 65536) {
+				fprintf(stderr, "Memoria del arbol invalida: %s MB.\n", argv[i]);
+				return 1;
+			}
+			game_set_tree_memory((size_t)mb << 20);
+		} else if (strcmp(argv[i], "--tt-mb") == 0 && i + 1 < argc) {
+			long mb = strtol(argv[++i], NULL, 10);
+			if (mb < 0 || mb > 65536) {
+				fprintf(stderr, "Memoria de la tabla de transposiciones invalida: %s MB.\n", argv[i]);
+				return 1;
+			}
+			game_set_tt_memory((size_t)mb << 20);
+		} else if (strcmp(argv[i], "--parallel") == 0 && i + 1 < argc) {
+			i++;
+			if (strcmp(argv[i], "thread") == 0) {
+				use_threads = 1;
+			} else if (strcmp(argv[i], "proc") == 0) {
+				use_threads = 0;
+			} else {
+				fprintf(stderr, "Paralelismo desconocido: %s (usa proc o thread).\n", argv[i]);
+				return 1;
+			}
+		} else if (strcmp(argv[i], "--ipc") == 0 && i + 1 < argc) {
+			i++;
+			if (strcmp(argv[i], "shm") == 0) {
+				ipc_mode = IPC_SHM;
+			} else if (strcmp(argv[i], "pipe") == 0) {
+				ipc_mode = IPC_PIPE;
+			} else {
+				fprintf(stderr, "Modo de comunicacion desconocido: %s (usa pipe o shm).\n", argv[i]);
+				return 1;
+			}
+		} else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+			char *end = NULL;
+			errno = 0;
+			master_seed = strtoull(argv[++i], &end, 0);
+			if (errno != 0 || end == argv[i] || *end != '\0') {
+				fprintf(stderr, "Semilla invalida: %s.\n", argv[i]);
+				return 1;
+			}
+			seed_fixed = 1;
+		} else if (strcmp(argv[i], "--book") == 0 && i + 1 < argc) {
+			if (book_open(&opening_book, argv[++i]) != 0) {
+				fprintf(stderr, "No se pudo abrir el libro de aperturas %s. Continuando sin libro.\n", argv[i]);
+			}
+		} else if (strcmp(argv[i], "--early-stop") == 0 && i + 1 < argc) {
+			char *end = NULL;
+			double factor = strtod(argv[++i], &end);
+			if (end == argv[i] || *end != '\0' || factor < 0.0) {
+				fprintf(stderr, "Factor de parada temprana invalido: %s.\n", argv[i]);
+				return 1;
+			}
+			game_set_early_stop(factor);
+		} else if (strcmp(argv[i], "--no-vc") == 0) {
+			vc_enabled = 0;
+		} else if (strcmp(argv[i], "--no-prune") == 0) {
+			game_set_prune(0);
+		} else if (strcmp(argv[i], "--no-rave") == 0) {
+			game_set_rave(0);
+		} else if (strcmp(argv[i], "--ponder") == 0) {
+			ponder_enabled = 1;
+		} else if ((strcmp(argv[i], "--movetime") == 0 || strcmp(argv[i], "--gametime") == 0) && i + 1 < argc) {
+			long ms = parse_duration_ms(argv[i + 1]);
+			if (ms <= 0) {
+				fprintf(stderr, "Tiempo invalido: %s (usa 500ms, 2s o milisegundos).\n", argv[i + 1]);
+				return 1;
+			}
+			if (strcmp(argv[i], "--movetime") == 0) movetime_ms = ms;
+			else gametime_ms = ms;
+			i++;
 		}
 	}
 
@@ -91,7 +233,9 @@ int main(int argc, char **argv) {
 	int requested_workers = determine_default_workers();
 
 	board_clear(board, size);
-	pcg32_srandom((uint64_t)time(NULL), (uint64_t)getpid());
+	// Con --seed el proceso principal usa el flujo 0 y cada trabajador el suyo (id + 1)
+	if (seed_fixed) game_seed(master_seed, 0);
+	else game_seed((uint64_t)time(NULL), (uint64_t)getpid());
 	snprintf(status_line, sizeof(status_line), "Configura el tamano, simulaciones y procesos.");
 
 	announce_board(board, size);
@@ -113,8 +257,9 @@ int main(int argc, char **argv) {
 	}
 	board_clear(board, size);
 
-	// Simulations prompt
-	while (1) {
+	// Simulations prompt (con reloj la busqueda se limita por tiempo)
+	if (movetime_ms > 0 || gametime_ms > 0) nsim = 0;
+	while (nsim > 0) {
 		if (!get_line("Simulaciones totales [4000] (hasta 1M): ", buffer, sizeof(buffer))) {
 			buffer[0] = '\0';
 		}
@@ -131,7 +276,8 @@ int main(int argc, char **argv) {
 
 	// Worker prompt
 	while (1) {
-		if (!get_line("Procesos de simulacion (1-32) [auto]: ", buffer, sizeof(buffer))) {
+		const char *label = use_threads ? "Hilos de busqueda (1-32) [auto]: " : "Procesos de simulacion (1-32) [auto]: ";
+		if (!get_line(label, buffer, sizeof(buffer))) {
 			buffer[0] = '\0';
 		}
 		if (buffer[0] == '\0') break;
@@ -145,15 +291,28 @@ int main(int argc, char **argv) {
 		announce_board(board, size);
 	}
 
-	if (spawn_workers(requested_workers) != 0) {
+	if (use_threads) {
+		// Un solo arbol compartido por todos los hilos dentro de este proceso
+		game_set_threads(requested_workers);
+	} else if (spawn_workers(requested_workers) != 0) {
 		fprintf(stderr, "No se pudieron crear trabajadores. Ejecutando en modo secuencial.\n");
 	}
+	if (ponder_enabled && worker_count == 0) {
+		fprintf(stderr, "La meditacion requiere procesos de simulacion. Desactivada.\n");
+		ponder_enabled = 0;
+	}
+	if (ponder_enabled && game_get_engine() != ENGINE_UCT) {
+		fprintf(stderr, "La meditacion requiere el motor uct. Desactivada.\n");
+		ponder_enabled = 0;
+	}
 
 	snprintf(status_line, sizeof(status_line), "Tu eres X (izquierda-derecha), la computadora es O (arriba-abajo).");
 	announce_board(board, size);
 
 	char turn = 'X';
 	int aborted = 0;
+	uint64_t board_key = board_hash(board, size);
+	int64_t clock_left = gametime_ms;
 
 	while (1) {
 		if (shutdown_requested) {
@@ -186,7 +345,7 @@ int main(int argc, char **argv) {
 					aborted = 1;
 					break;
 				}
-				if (!place_token(board, size, move, 'X')) {
+				if (!place_token_hash(board, size, move, 'X', &board_key)) {
 					snprintf(status_line, sizeof(status_line), "Casilla ocupada o invalida.");
 					continue;
 				}
@@ -208,7 +367,7 @@ int main(int argc, char **argv) {
 					snprintf(status_line, sizeof(status_line), "Movimiento invalido. Usa formato letra-numero.");
 					continue;
 				}
-				if (!place_token(board, size, move, 'X')) {
+				if (!place_token_hash(board, size, move, 'X', &board_key)) {
 					snprintf(status_line, sizeof(status_line), "Casilla ocupada o invalida.");
 					continue;
 				}
@@ -220,27 +379,87 @@ int main(int argc, char **argv) {
 		} else {
 			snprintf(status_line, sizeof(status_line), "La computadora esta pensando...");
 			announce_board(board, size);
-			if (parallel_stats(board, size, 'O', nsim, stats) != 0) {
-				game_stats(board, size, 'O', nsim, stats);
+			int free_cells = 0;
+			for (int i = 0; i < size * size; i++) free_cells += (board[i] == '+');
+			search_budget_t budget = {nsim, movetime_ms};
+			if (gametime_ms > 0) budget.time_ms = move_time_budget(clock_left, free_cells, movetime_ms);
+			int64_t playouts = 0;
+			int stopped = 0;
+			double started = clock_ms();
+			// Las aperturas conocidas se juegan sin buscar
+			int move = book_lookup(&opening_book, board_key, size, 'O');
+			int from_book = (move >= 0 && board[move] == '+');
+			// Con conexiones virtuales: una victoria demostrada o una sola casilla que
+			// corta todas las amenazas del rival se juegan sin buscar; en una derrota
+			// demostrada basta una fraccion del presupuesto para elegir la resistencia
+			vc_result_t vc;
+			int forced = 0;
+			vc.status = VC_OPEN;
+			vc.mustplay_count = 0;
+			if (!from_book && vc_enabled) {
+				position_t pos;
+				position_from_board(&pos, board, size);
+				if (vc_analyze(&pos, size, 'O', &vc)) {
+					if (vc.status == VC_WIN) {
+						move = vc.move;
+						forced = 1;
+					} else if (vc.status == VC_OPEN && vc.mustplay_count == 1) {
+						for (move = 0; !bs_get(&vc.mustplay, move); move++);
+						forced = 1;
+					} else if (vc.status == VC_LOSS) {
+						if (budget.nsim > 0) budget.nsim = budget.nsim / 8 + 1;
+						if (budget.time_ms > 0) budget.time_ms = budget.time_ms / 8 + 1;
+					}
+				}
 			}
-			int move = game_move(stats, size);
-			if (!place_token(board, size, move, 'O')) {
+			if (!from_book && !forced) {
+				// Fuera de la zona obligada toda jugada pierde contra la amenaza del rival:
+				// la busqueda solo considera esas casillas en la raiz
+				const bitset_t *root_only = vc.mustplay_count > 1 ? &vc.mustplay : NULL;
+				if (parallel_stats(board, size, 'O', root_only, &budget, stats, &playouts, &stopped) != 0) {
+					playouts = game_search(board, size, 'O', &budget, stats);
+					stopped = game_search_stopped();
+				}
+				move = game_move(stats, size);
+			}
+			double elapsed = clock_ms() - started;
+			if (gametime_ms > 0) clock_left -= (int64_t)elapsed;
+			if (!place_token_hash(board, size, move, 'O', &board_key)) {
 				for (int i = 0; i < size * size; i++) {
 					if (board[i] == '+') {
 						move = i;
-						place_token(board, size, move, 'O');
+						place_token_hash(board, size, move, 'O', &board_key);
 						break;
 					}
 				}
 			}
 			int x, y;
 			to_xy(size, move, &x, &y);
-			snprintf(status_line, sizeof(status_line), "La computadora juega %c%d.", 'A' + x, y + 1);
+			// Lo ahorrado por la parada temprana: tiempo si hay limite de tiempo, si no simulaciones
+			long long saved = 0;
+			if (stopped && budget.time_ms > 0) saved = (long long)((budget.time_ms - elapsed) * 100.0 / budget.time_ms);
+			else if (stopped && budget.nsim > 0) saved = (long long)((budget.nsim - playouts) * 100 / budget.nsim);
+			if (from_book) {
+				snprintf(status_line, sizeof(status_line), "La computadora juega %c%d (libro de aperturas).", 'A' + x, y + 1);
+			} else if (forced) {
+				snprintf(status_line, sizeof(status_line), "La computadora juega %c%d (%s).", 'A' + x, y + 1,
+					vc.status == VC_WIN ? "conexion virtual ganadora" : "unica defensa");
+			} else if (saved >= 1) {
+				snprintf(status_line, sizeof(status_line), "La computadora juega %c%d (%lld simulaciones en %.0f ms; parada temprana, %lld%% del presupuesto ahorrado).",
+					'A' + x, y + 1, (long long)playouts, elapsed, saved);
+			} else {
+				snprintf(status_line, sizeof(status_line), "La computadora juega %c%d (%lld simulaciones en %.0f ms).",
+					'A' + x, y + 1, (long long)playouts, elapsed);
+			}
 			turn = 'X';
+			if (ponder_enabled && board_status(board, size) == none && board_has_free(board, size)) {
+				start_pondering(board, size, 'X', nsim > 0 ? nsim : MAX_SIMULATIONS);
+			}
 		}
 	}
 
 	stop_workers();
+	book_close(&opening_book);
 
 	if (aborted) {
 		snprintf(status_line, sizeof(status_line), "Juego terminado por el usuario.");
@@ -272,55 +491,104 @@ static int determine_default_workers(void) {
 	return (int)cpus;
 }
 
-static ssize_t read_full(int fd, void *buf, size_t count) {
-	size_t left = count;
-	char *ptr = buf;
-	while (left > 0) {
-		ssize_t r = read(fd, ptr, left);
-		if (r < 0) {
-			if (errno == EINTR) continue;
-			return -1;
-		}
-		if (r == 0) return count - left;
-		left -= (size_t)r;
-		ptr += r;
-	}
-	return (ssize_t)count;
+static int fd_readable(int fd) {
+	struct pollfd pfd = {fd, POLLIN, 0};
+	return poll(&pfd, 1, 0) > 0;
 }
 
-static ssize_t write_full(int fd, const void *buf, size_t count) {
-	size_t left = count;
-	const char *ptr = buf;
-	while (left > 0) {
-		ssize_t r = write(fd, ptr, left);
-		if (r < 0) {
-			if (errno == EINTR) continue;
-			return -1;
+// Publica con un seqlock: seq impar mientras se escribe, par al terminar
+static void slot_publish(result_slot_t *slot, int job, int64_t playouts, const int64_t *stats, int cells) {
+	uint32_t seq = __atomic_load_n(&slot->seq, __ATOMIC_RELAXED);
+	__atomic_store_n(&slot->seq, seq + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	slot->job = job;
+	slot->playouts = playouts;
+	memcpy(slot->stats, stats, (size_t)cells * sizeof(stats[0]));
+	__atomic_store_n(&slot->seq, seq + 2, __ATOMIC_RELEASE);
+}
+
+// Copia consistente de una ranura; regresa 0 si aun no tiene datos del trabajo. Si la
+// escritura no termina tras SLOT_RETRIES intentos (el trabajador murio a la mitad) la
+// ranura se trata como vacia.
+static int slot_snapshot(const result_slot_t *slot, int job, int cells, int64_t *stats, int64_t *playouts) {
+	for (int tries = 0; tries < SLOT_RETRIES; tries++) {
+		uint32_t seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+		if (seq & 1u) {
+			sched_yield();
+			continue;
 		}
-		left -= (size_t)r;
-		ptr += r;
+		int slot_job = slot->job;
+		*playouts = slot->playouts;
+		memcpy(stats, slot->stats, (size_t)cells * sizeof(stats[0]));
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) == seq) return slot_job == job;
 	}
-	return (ssize_t)count;
+	return 0;
 }
 
-static void worker_loop(int read_fd, int write_fd) {
+// Mientras medita, el trabajador busca en lotes pequenos y revisa la tuberia entre
+// lotes; cualquier peticion nueva (busqueda o fin) interrumpe la meditacion.
+static void worker_loop(int index, int read_fd, int write_fd) {
 	worker_request_t request;
-	worker_response_t response;
-	pcg32_srandom((uint64_t)time(NULL), (uint64_t)getpid());
+	worker_request_t ponder;
+	int ponder_left = 0;
+	int job = 0;
+	int64_t job_playouts = 0;
+	int64_t job_stats[MAX_BOARD_SIZE];
+	int64_t batch[MAX_BOARD_SIZE];
+	result_slot_t *slot = (ipc_mode == IPC_SHM && result_slots) ? &result_slots[index] : NULL;
+	if (seed_fixed) game_seed(master_seed, (uint64_t)index + 1);
+	else game_seed((uint64_t)time(NULL), (uint64_t)getpid());
+	// Cada peticion es un lote de la jugada y el arbol acumula visitas de lotes y turnos
+	// anteriores: comparadas con lo que queda del lote, la parada temprana se dispararia
+	// sin que nada este decidido. Solo la aplica el padre con las estadisticas sumadas.
+	game_set_early_stop(0.0);
 	while (1) {
-		memset(&request, 0, sizeof(request));
-		ssize_t got = read_full(read_fd, &request, sizeof(request));
-		if (got != (ssize_t)sizeof(request)) break;
-		if (request.cmd == 0) break;
-		if (request.cmd == 1) {
-			if (request.size <= 0 || request.nsim <= 0) continue;
-			memset(&response, 0, sizeof(response));
-			response.cmd = 1;
-			response.size = request.size;
-			game_stats(request.board, request.size, request.player, request.nsim, response.stats);
-			if (write_full(write_fd, &response, sizeof(response)) != (ssize_t)sizeof(response)) {
+		if (ponder_left > 0 && !fd_readable(read_fd)) {
+			int chunk = ponder_left < PONDER_BATCH ? ponder_left : PONDER_BATCH;
+			if (!game_ponder(ponder.board, ponder.size, ponder.player, chunk)) ponder_left = 0;
+			else ponder_left -= chunk;
+			continue;
+		}
+		if (proto_recv_request(read_fd, &request) != 0) break;
+		ponder_left = 0;
+		if (request.cmd == WORKER_CMD_STOP) break;
+		if (request.cmd == WORKER_CMD_SEARCH) {
+			if (request.size <= 0 || (request.nsim <= 0 && request.time_ms <= 0)) continue;
+			// Los resultados acumulan todos los lotes del mismo trabajo
+			int cells = request.size * request.size;
+			int fresh = (request.job != job);
+			if (fresh) {
+				job = request.job;
+				job_playouts = 0;
+			}
+			search_budget_t budget = {request.nsim, request.time_ms};
+			game_restrict_root(request.restrict_root ? &request.root_only : NULL);
+			job_playouts += game_search(request.board, request.size, request.player, &budget, batch);
+			if (fresh || game_search_cumulative()) {
+				memcpy(job_stats, batch, (size_t)cells * sizeof(batch[0]));
+			} else {
+				for (int k = 0; k < cells; k++) {
+					if (batch[k] != INT64_MIN) job_stats[k] += batch[k];
+				}
+			}
+			// Con memoria compartida solo se avisa: los contadores ya estan en la ranura
+			if (slot) slot_publish(slot, job, job_playouts, job_stats, cells);
+			if (proto_send_stats(write_fd, request.board, request.size, job, job_playouts, slot ? NULL : job_stats) != 0) {
+				break;
+			}
+		} else if (request.cmd == WORKER_CMD_EVAL) {
+			// Una fase del plan plano: victorias por casilla, siempre por la tuberia
+			int64_t counts[MAX_BOARD_SIZE];
+			for (int k = 0; k < request.size * request.size; k++) counts[k] = request.counts[k];
+			int64_t done = game_eval(request.board, request.size, request.player, counts, batch);
+			if (proto_send_stats(write_fd, request.board, request.size, request.job, done, batch) != 0) {
 				break;
 			}
+		} else if (request.cmd == WORKER_CMD_PONDER) {
+			if (request.size <= 0 || request.nsim <= 0) continue;
+			ponder = request;
+			ponder_left = request.nsim;
 		}
 	}
 	close(read_fd);
@@ -331,6 +599,18 @@ static void worker_loop(int read_fd, int write_fd) {
 static int spawn_workers(int count) {
 	if (count < 1) count = 1;
 	if (count > MAX_PROC) count = MAX_PROC;
+	if (ipc_mode == IPC_SHM) {
+		// Region compartida creada antes del fork: cada hijo escribe en su ranura
+		result_slots_len = sizeof(result_slot_t) * (size_t)count;
+		void *region = mmap(NULL, result_slots_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+		if (region == MAP_FAILED) {
+			fprintf(stderr, "No se pudo crear la memoria compartida. Usando tuberias.\n");
+			ipc_mode = IPC_PIPE;
+		} else {
+			result_slots = region;
+			memset(result_slots, 0, result_slots_len);
+		}
+	}
 	for (int i = 0; i < count; i++) {
 		if (pipe(workers[i].to_child) != 0) {
 			stop_workers();
@@ -353,7 +633,7 @@ static int spawn_workers(int count) {
 		} else if (pid == 0) {
 			close(workers[i].to_child[1]);
 			close(workers[i].from_child[0]);
-			worker_loop(workers[i].to_child[0], workers[i].from_child[1]);
+			worker_loop(i, workers[i].to_child[0], workers[i].from_child[1]);
 		} else {
 			workers[i].pid = pid;
 			close(workers[i].to_child[0]);
@@ -366,9 +646,9 @@ static int spawn_workers(int count) {
 
 static void stop_workers(void) {
 	worker_request_t request = {0};
-	request.cmd = 0;
+	request.cmd = WORKER_CMD_STOP;
 	for (int i = 0; i < worker_count; i++) {
-		write_full(workers[i].to_child[1], &request, sizeof(request));
+		proto_send_request(workers[i].to_child[1], &request);
 		close(workers[i].to_child[1]);
 		close(workers[i].from_child[0]);
 	}
@@ -377,13 +657,134 @@ static void stop_workers(void) {
 		waitpid(workers[i].pid, &status, 0);
 	}
 	worker_count = 0;
+	if (result_slots) {
+		munmap(result_slots, result_slots_len);
+		result_slots = NULL;
+	}
+}
+
+// Suma la ultima respuesta de cada trabajador (cada una ya acumula sus lotes).
+// Una casilla libre en INT64_MIN la descarto el analisis de casillas inferiores.
+static void merge_worker_stats(const char *board, int size, int job, const int *answered, int64_t *worker_playouts, int64_t *stats, int64_t *playouts) {
+	*playouts = 0;
+	for (int i = 0; i < size * size; i++) {
+		stats[i] = (board[i] == '+') ? 0 : INT64_MIN;
+	}
+	for (int w = 0; w < worker_count; w++) {
+		if (!answered[w]) continue;
+		if (result_slots && !slot_snapshot(&result_slots[w], job, size * size, worker_stats[w], &worker_playouts[w])) continue;
+		*playouts += worker_playouts[w];
+		for (int k = 0; k < size * size; k++) {
+			if (worker_stats[w][k] == INT64_MIN) {
+				stats[k] = INT64_MIN;
+				continue;
+			}
+			if (stats[k] == INT64_MIN) continue;
+			stats[k] += worker_stats[w][k];
+		}
+	}
 }
 
-static int parallel_stats(const char *board,int size,char player,int total_sims,int64_t *stats) {
-	if (worker_count <= 0 || total_sims <= 0 || size <= 0) {
-		game_stats(board, size, player, total_sims, stats);
+// Motor plano con trabajadores y presupuesto por simulaciones: el padre lleva el plan
+// por fases (flat_plan_*) y reparte cada fase entre todos. Asi la pasada rapida se hace
+// una sola vez y la asignacion siguiente sale de los resultados de todos, en lugar de
+// que cada trabajador repita el plan completo con sus estadisticas locales.
+static int coordinated_stats(const char *board, int size, char player, const search_budget_t *budget, int64_t *stats, int64_t *playouts, int *stopped) {
+	flat_plan_t plan;
+	int64_t counts[MAX_BOARD_SIZE];
+	int64_t wins[MAX_BOARD_SIZE];
+	int64_t reply[MAX_BOARD_SIZE];
+	int cells = size * size;
+	worker_request_t request;
+	memset(&request, 0, sizeof(request));
+	request.cmd = WORKER_CMD_EVAL;
+	request.size = size;
+	request.player = player;
+	memcpy(request.board, board, (size_t)cells);
+
+	flat_plan_init(&plan, board, size, player, budget->nsim);
+	while (flat_plan_next(&plan, counts)) {
+		int busy[MAX_PROC] = {0};
+		int pending = 0;
+		request.job = ++job_counter;
+		for (int w = 0; w < worker_count; w++) {
+			int any = 0;
+			// Reparto parejo de cada casilla; el residuo rota por casilla para equilibrar
+			for (int i = 0; i < cells; i++) {
+				int64_t extra = (((w - i % worker_count) + worker_count) % worker_count < counts[i] % worker_count) ? 1 : 0;
+				request.counts[i] = (int32_t)(counts[i] / worker_count + extra);
+				any |= (request.counts[i] > 0);
+			}
+			if (!any) continue;
+			if (proto_send_request(workers[w].to_child[1], &request) != 0) {
+				stop_workers();
+				return -1;
+			}
+			busy[w] = 1;
+			pending++;
+		}
+		for (int i = 0; i < cells; i++) wins[i] = 0;
+		while (pending > 0) {
+			struct pollfd fds[MAX_PROC];
+			int owner[MAX_PROC];
+			int nfds = 0;
+			for (int w = 0; w < worker_count; w++) {
+				if (!busy[w]) continue;
+				fds[nfds].fd = workers[w].from_child[0];
+				fds[nfds].events = POLLIN;
+				fds[nfds].revents = 0;
+				owner[nfds++] = w;
+			}
+			if (poll(fds, (nfds_t)nfds, -1) < 0) {
+				if (errno == EINTR) continue;
+				stop_workers();
+				return -1;
+			}
+			for (int f = 0; f < nfds; f++) {
+				if (!(fds[f].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+				int w = owner[f];
+				int reply_job;
+				int64_t done;
+				if (proto_recv_stats(fds[f].fd, board, size, &reply_job, &done, reply) != 0 || reply_job != request.job) {
+					stop_workers();
+					return -1;
+				}
+				for (int i = 0; i < cells; i++) {
+					if (reply[i] != INT64_MIN) wins[i] += reply[i];
+				}
+				busy[w] = 0;
+				pending--;
+			}
+		}
+		flat_plan_record(&plan, counts, wins);
+		// Parada temprana entre fases (determinista: cada fase se completa entera)
+		flat_plan_stats(&plan, stats);
+		if (plan.phase < plan.phases && game_decided(stats, size, plan.nsim - plan.done)) {
+			*stopped = 1;
+			break;
+		}
+	}
+	*playouts = flat_plan_stats(&plan, stats);
+	return 0;
+}
+
+// Reparte el presupuesto entre los trabajadores: las simulaciones se dividen y el
+// limite de tiempo se aplica igual a todos. 'root_only' (o NULL) limita las jugadas de
+// la raiz, aqui y en los trabajadores. 'playouts' recibe las simulaciones hechas y
+// 'stopped' queda en 1 si la parada temprana corto el reparto.
+static int parallel_stats(const char *board,int size,char player,const bitset_t *root_only,const search_budget_t *budget,int64_t *stats,int64_t *playouts,int *stopped) {
+	int64_t total_sims = budget->nsim;
+	*playouts = 0;
+	*stopped = 0;
+	game_restrict_root(root_only);
+	if (worker_count <= 0 || (total_sims <= 0 && budget->time_ms <= 0) || size <= 0) {
+		*playouts = game_search(board, size, player, budget, stats);
+		*stopped = game_search_stopped();
 		return 0;
 	}
+	if (game_get_engine() == ENGINE_FLAT && budget->time_ms <= 0) {
+		return coordinated_stats(board, size, player, budget, stats, playouts, stopped);
+	}
 
 	for (int i = 0; i < size * size; i++) {
 		stats[i] = (board[i] == '+') ? 0 : INT64_MIN;
@@ -391,51 +792,136 @@ static int parallel_stats(const char *board,int size,char player,int total_sims,
 
 	worker_request_t request;
 	memset(&request, 0, sizeof(request));
-	request.cmd = 1;
+	request.cmd = WORKER_CMD_SEARCH;
 	request.size = size;
+	request.job = ++job_counter;
 	request.player = player;
+	request.time_ms = (int)budget->time_ms;
+	request.restrict_root = (root_only != NULL);
+	if (root_only) request.root_only = *root_only;
 	memcpy(request.board, board, (size_t)size * (size_t)size);
 
-	int base = total_sims / worker_count;
-	int remainder = total_sims % worker_count;
-	int used_workers[MAX_PROC];
-	int active = 0;
-
+	// Con limite de tiempo todos terminan a la vez: un solo lote por trabajador.
+	// Por numero de simulaciones se reparten lotes pequenos a quien termina primero,
+	// asi un nucleo lento recibe menos trabajo en vez de retrasar la jugada.
+	// Con --seed cada trabajador tiene una cuota fija: sus lotes (y sus numeros
+	// aleatorios) ya no dependen de quien termine primero.
+	int64_t batch;
+	if (budget->time_ms > 0) {
+		batch = total_sims > 0 ? (total_sims + worker_count - 1) / worker_count : 0;
+	} else {
+		batch = total_sims / ((int64_t)worker_count * BATCHES_PER_WORKER);
+		if (batch < MIN_BATCH) batch = MIN_BATCH;
+	}
+	int64_t assigned = 0;
+	int64_t quota[MAX_PROC];
+	int inflight[MAX_PROC] = {0};
+	int64_t worker_playouts[MAX_PROC] = {0};
+	int answered[MAX_PROC] = {0};
+	int pending = 0;
+	int early_check = (budget->time_ms <= 0 && !seed_fixed);
 	for (int i = 0; i < worker_count; i++) {
-		int share = base + (i < remainder ? 1 : 0);
-		if (share < 1) share = 1;
-		request.nsim = share;
-		if (write_full(workers[i].to_child[1], &request, sizeof(request)) != (ssize_t)sizeof(request)) {
-			stop_workers();
-			game_stats(board, size, player, total_sims, stats);
-			return -1;
-		}
-		used_workers[active++] = i;
+		quota[i] = total_sims / worker_count + (i < total_sims % worker_count ? 1 : 0);
 	}
 
-	if (active == 0) {
-		game_stats(board, size, player, total_sims, stats);
-		return 0;
+	for (int round = 0; round < MAX_INFLIGHT; round++) {
+		for (int i = 0; i < worker_count; i++) {
+			if (budget->time_ms > 0 && round > 0) break;
+			int64_t left = seed_fixed ? quota[i] : total_sims - assigned;
+			if (budget->time_ms <= 0 && left <= 0) continue;
+			int64_t n = batch;
+			if (total_sims > 0 && left < n) n = left;
+			request.nsim = (int)n;
+			if (proto_send_request(workers[i].to_child[1], &request) != 0) {
+				stop_workers();
+				*playouts = game_search(board, size, player, budget, stats);
+				return -1;
+			}
+			assigned += n;
+			quota[i] -= n;
+			inflight[i]++;
+			pending++;
+		}
 	}
 
-	for (int idx = 0; idx < active; idx++) {
-		int worker_index = used_workers[idx];
-		worker_response_t response;
-		memset(&response, 0, sizeof(response));
-		if (read_full(workers[worker_index].from_child[0], &response, sizeof(response)) != (ssize_t)sizeof(response)) {
+	while (pending > 0) {
+		struct pollfd fds[MAX_PROC];
+		int owner[MAX_PROC];
+		int nfds = 0;
+		for (int i = 0; i < worker_count; i++) {
+			if (inflight[i] == 0) continue;
+			fds[nfds].fd = workers[i].from_child[0];
+			fds[nfds].events = POLLIN;
+			fds[nfds].revents = 0;
+			owner[nfds++] = i;
+		}
+		if (poll(fds, (nfds_t)nfds, -1) < 0) {
+			if (errno == EINTR) continue;
 			stop_workers();
-			game_stats(board, size, player, total_sims, stats);
+			*playouts = game_search(board, size, player, budget, stats);
 			return -1;
 		}
-		for (int k = 0; k < size * size; k++) {
-			if (response.stats[k] == INT64_MIN) continue;
-			if (stats[k] == INT64_MIN) continue;
-			stats[k] += response.stats[k];
+		for (int f = 0; f < nfds; f++) {
+			if (!(fds[f].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+			int w = owner[f];
+			int reply_job;
+			if (proto_recv_stats(fds[f].fd, board, size, &reply_job, &worker_playouts[w], result_slots ? NULL : worker_stats[w]) != 0 ||
+			    reply_job != request.job) {
+				stop_workers();
+				*playouts = game_search(board, size, player, budget, stats);
+				return -1;
+			}
+			inflight[w]--;
+			pending--;
+			answered[w] = 1;
+			// Entre lotes: si la mejor jugada de la suma ya no puede ser alcanzada con lo
+			// que falta, no se reparten mas (los lotes en curso se terminan y se suman).
+			// Con --seed no se revisa: el resultado dependeria del orden de llegada.
+			if (early_check && !*stopped) {
+				int64_t done;
+				merge_worker_stats(board, size, request.job, answered, worker_playouts, stats, &done);
+				if (total_sims > done && game_decided(stats, size, total_sims - done)) *stopped = 1;
+			}
+			int64_t left = seed_fixed ? quota[w] : total_sims - assigned;
+			if (!*stopped && budget->time_ms <= 0 && left > 0) {
+				int64_t n = left < batch ? left : batch;
+				request.nsim = (int)n;
+				if (proto_send_request(workers[w].to_child[1], &request) != 0) {
+					stop_workers();
+					*playouts = game_search(board, size, player, budget, stats);
+					return -1;
+				}
+				assigned += n;
+				quota[w] -= n;
+				inflight[w]++;
+				pending++;
+			}
 		}
 	}
+
+	merge_worker_stats(board, size, request.job, answered, worker_playouts, stats, playouts);
 	return 0;
 }
 
+// Pide a los trabajadores que sigan buscando la posicion del rival mientras este piensa.
+// No hay respuesta: la siguiente peticion de busqueda interrumpe la meditacion y el
+// arbol de cada trabajador conserva lo aprendido bajo la jugada real.
+static void start_pondering(const char *board,int size,char player,int total_sims) {
+	worker_request_t request;
+	memset(&request, 0, sizeof(request));
+	request.cmd = WORKER_CMD_PONDER;
+	request.size = size;
+	request.player = player;
+	memcpy(request.board, board, (size_t)size * (size_t)size);
+	int base = total_sims / (worker_count > 0 ? worker_count : 1);
+	for (int i = 0; i < worker_count; i++) {
+		request.nsim = base > 0 ? base : 1;
+		if (proto_send_request(workers[i].to_child[1], &request) != 0) {
+			return;
+		}
+	}
+}
+
 static int get_line(const char *prompt, char *buffer, size_t len) {
 	if (gui_enabled) {
 		if (!ui_prompt(prompt, buffer, len)) {
@@ -455,6 +941,26 @@ static int get_line(const char *prompt, char *buffer, size_t len) {
 	return 1;
 }
 
+// Acepta "500", "500ms" o "2s"
+static long parse_duration_ms(const char *text) {
+	char *endptr = NULL;
+	long value = strtol(text, &endptr, 10);
+	if (endptr == text || value <= 0) return -1;
+	if (*endptr == '\0' || strcmp(endptr, "ms") == 0) return value;
+	if (strcmp(endptr, "s") == 0) return value * 1000;
+	return -1;
+}
+
+// Con reloj de partida se gasta una fraccion del tiempo restante segun las casillas
+// libres (una partida rara vez llena el tablero, de ahi el tercio); --movetime es el tope.
+static int64_t move_time_budget(int64_t clock_left, int free_cells, int64_t movetime) {
+	int64_t moves_to_go = free_cells / 3 + 1;
+	int64_t slice = clock_left / moves_to_go;
+	if (movetime > 0 && slice > movetime) slice = movetime;
+	if (slice < MIN_MOVE_TIME_MS) slice = MIN_MOVE_TIME_MS;
+	return slice;
+}
+
 static void announce_board(const char *board, int size) {
 	if (gui_enabled) {
 		ui_draw_board(board, size, status_line);
@@ -0,0 +1,520 @@
+#include "mcts.h"
+#include "playout.h"
+#include "inferior.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+int mcts_tree_init(mcts_tree_t *tree, size_t memory, size_t tt_memory) {
+	size_t capacity = memory / sizeof(mcts_node_t);
+	if (capacity < MAX_BOARD_SIZE + 1) capacity = MAX_BOARD_SIZE + 1;
+	if (capacity > INT32_MAX) capacity = INT32_MAX;
+	size_t words = (capacity + 63) / 64;
+	tree->nodes = malloc(capacity * sizeof(mcts_node_t));
+	tree->keep = malloc(words * sizeof(uint64_t));
+	tree->rank = malloc(words * sizeof(uint32_t));
+	int tt_failed = tt_init(&tree->tt, tt_memory);
+	if (!tree->nodes || !tree->keep || !tree->rank || tt_failed) {
+		mcts_tree_free(tree);
+		return -1;
+	}
+	tree->capacity = (int32_t)capacity;
+	tree->used = 0;
+	tree->root = -1;
+	tree->size = 0;
+	tree->rave = 1;
+	tree->prune = 0;
+	tree->early_stop = 0.0;
+	tree->restrict_root = 0;
+	playout_get_options(&tree->playout);
+	return 0;
+}
+
+void mcts_tree_free(mcts_tree_t *tree) {
+	free(tree->nodes);
+	free(tree->keep);
+	free(tree->rank);
+	tt_free(&tree->tt);
+	tree->nodes = NULL;
+	tree->keep = NULL;
+	tree->rank = NULL;
+	tree->capacity = 0;
+	tree->used = 0;
+	tree->root = -1;
+}
+
+// Reserva un bloque contiguo; los hilos compiten por 'used' con CAS
+static int32_t node_alloc(mcts_tree_t *tree, int count) {
+	int32_t first = __atomic_load_n(&tree->used, __ATOMIC_RELAXED);
+	do {
+		if (first + count > tree->capacity) return -1;
+	} while (!__atomic_compare_exchange_n(&tree->used, &first, first + count, 1,
+		__ATOMIC_RELAXED, __ATOMIC_RELAXED));
+	return first;
+}
+
+static void node_init(mcts_node_t *node, int move) {
+	node->first_child = -1;
+	node->move = (int16_t)move;
+	node->child_count = 0;
+	node->visits = 0;
+	node->wins = 0;
+	node->amaf_visits = 0;
+	node->amaf_wins = 0;
+}
+
+// Movimientos de la raiz que se buscan: todas las vacias, o sin las inferiores, y
+// dentro de 'root_only' si hay restriccion. Si la raiz ya tiene hijos (arbol
+// reutilizado) los descartados se sacan del bloque compactando los demas al inicio;
+// sus subarboles quedan para la siguiente compactacion. Ningun otro nodo comparte el
+// bloque de la raiz: una transposicion suya tendria las mismas fichas y ya no queda
+// ninguna a esa profundidad. Regresa 0 si falta el hijo de algun candidato (la raiz
+// se expandio con una restriccion distinta) y hay que empezar de cero.
+static int root_candidates(mcts_tree_t *tree) {
+	bs_board_mask(&tree->root_moves, tree->size);
+	for (int w = 0; w < BB_WORDS; w++) tree->root_moves.w[w] &= ~(tree->pos.x.w[w] | tree->pos.o.w[w]);
+	if (tree->prune) inferior_filter(&tree->pos, tree->size, tree->player, &tree->root_moves);
+	if (tree->restrict_root) {
+		bitset_t only;
+		int any = 0;
+		for (int w = 0; w < BB_WORDS; w++) {
+			only.w[w] = tree->root_moves.w[w] & tree->root_only.w[w];
+			any |= (only.w[w] != 0);
+		}
+		if (any) tree->root_moves = only;
+	}
+	mcts_node_t *root = &tree->nodes[tree->root];
+	if (root->first_child < 0) return 1;
+	int wanted = 0;
+	for (int w = 0; w < BB_WORDS; w++) wanted += __builtin_popcountll(tree->root_moves.w[w]);
+	int kept = 0;
+	for (int k = 0; k < root->child_count; k++) {
+		mcts_node_t child = tree->nodes[root->first_child + k];
+		if (bs_get(&tree->root_moves, child.move)) tree->nodes[root->first_child + kept++] = child;
+	}
+	if (kept > 0) root->child_count = (int16_t)kept;
+	return kept == wanted || wanted == 0;
+}
+
+// Descarta el arbol y crea una raiz nueva para la posicion dada
+void mcts_reset(mcts_tree_t *tree, const char *board, int size, char player) {
+	tree->used = 0;
+	tree->size = size;
+	tree->player = player;
+	position_from_board(&tree->pos, board, size);
+	tree->hash = position_hash(&tree->pos, size);
+	tt_new_generation(&tree->tt);
+	tree->root = node_alloc(tree, 1);
+	node_init(&tree->nodes[tree->root], -1);
+	root_candidates(tree);
+}
+
+static inline int32_t compact_index(const mcts_tree_t *tree, int32_t index) {
+	uint64_t below = tree->keep[index >> 6] & (((uint64_t)1 << (index & 63)) - 1);
+	return (int32_t)tree->rank[index >> 6] + __builtin_popcountll(below);
+}
+
+// Promueve 'index' a raiz y recupera el resto de la arena. Un bloque de hijos esta
+// despues del primer padre que lo creo, asi que un recorrido ascendente marca casi
+// todo el subgrafo; si una transposicion apunta a un bloque anterior se repite la
+// pasada. Moviendo los nodos en orden ascendente ningun destino pisa a un nodo
+// pendiente (el nuevo indice nunca es mayor que el original).
+static void promote(mcts_tree_t *tree, int32_t index) {
+	int32_t words = (tree->used + 63) / 64;
+	int again = 1;
+	memset(tree->keep, 0, (size_t)words * sizeof(uint64_t));
+	tree->keep[index >> 6] |= (uint64_t)1 << (index & 63);
+	while (again) {
+		again = 0;
+		for (int32_t i = 0; i < tree->used; i++) {
+			if (!((tree->keep[i >> 6] >> (i & 63)) & 1u)) continue;
+			const mcts_node_t *node = &tree->nodes[i];
+			for (int k = 0; k < node->child_count; k++) {
+				int32_t c = node->first_child + k;
+				uint64_t bit = (uint64_t)1 << (c & 63);
+				if (tree->keep[c >> 6] & bit) continue;
+				tree->keep[c >> 6] |= bit;
+				if (c < i) again = 1;
+			}
+		}
+	}
+	uint32_t total = 0;
+	for (int32_t w = 0; w < words; w++) {
+		tree->rank[w] = total;
+		total += (uint32_t)__builtin_popcountll(tree->keep[w]);
+	}
+	int32_t root = compact_index(tree, index);
+	for (int32_t i = 0; i < tree->used; i++) {
+		if (!((tree->keep[i >> 6] >> (i & 63)) & 1u)) continue;
+		mcts_node_t node = tree->nodes[i];
+		if (node.child_count > 0) node.first_child = compact_index(tree, node.first_child);
+		tree->nodes[compact_index(tree, i)] = node;
+	}
+	tree->used = (int32_t)total;
+	tree->root = root;
+	tt_new_generation(&tree->tt);
+}
+
+static int32_t find_child(const mcts_tree_t *tree, int32_t index, int move) {
+	const mcts_node_t *node = &tree->nodes[index];
+	for (int k = 0; k < node->child_count; k++) {
+		if (tree->nodes[node->first_child + k].move == move) return node->first_child + k;
+	}
+	return -1;
+}
+
+// Reutiliza el arbol si la posicion nueva se alcanza desde la raiz actual
+// (normalmente la jugada elegida y la respuesta del rival). Las fichas nuevas se
+// recorren alternando colores desde el jugador en turno de la raiz; si no hay
+// camino en el arbol se empieza de cero. Regresa 1 si se conservo un subarbol.
+int mcts_set_root(mcts_tree_t *tree, const char *board, int size, char player) {
+	position_t target;
+	position_from_board(&target, board, size);
+	if (tree->root < 0 || tree->size != size) {
+		mcts_reset(tree, board, size, player);
+		return 0;
+	}
+	bitset_t added_x, added_o;
+	int count_x = 0, count_o = 0;
+	for (int w = 0; w < BB_WORDS; w++) {
+		if ((tree->pos.x.w[w] & ~target.x.w[w]) || (tree->pos.o.w[w] & ~target.o.w[w])) {
+			mcts_reset(tree, board, size, player);
+			return 0;
+		}
+		added_x.w[w] = target.x.w[w] & ~tree->pos.x.w[w];
+		added_o.w[w] = target.o.w[w] & ~tree->pos.o.w[w];
+		count_x += __builtin_popcountll(added_x.w[w]);
+		count_o += __builtin_popcountll(added_o.w[w]);
+	}
+	int32_t index = tree->root;
+	char turn = tree->player;
+	while (count_x + count_o > 0) {
+		bitset_t *added = (turn == 'X') ? &added_x : &added_o;
+		int *count = (turn == 'X') ? &count_x : &count_o;
+		int32_t next = -1;
+		for (int i = 0; *count > 0 && i < size * size && next < 0; i++) {
+			if (bs_get(added, i)) next = find_child(tree, index, i);
+		}
+		if (next < 0) {
+			mcts_reset(tree, board, size, player);
+			return 0;
+		}
+		bs_reset(added, tree->nodes[next].move);
+		(*count)--;
+		index = next;
+		turn = (turn == 'X') ? 'O' : 'X';
+	}
+	if (turn != player) {
+		mcts_reset(tree, board, size, player);
+		return 0;
+	}
+	if (index != tree->root) promote(tree, index);
+	tree->pos = target;
+	tree->hash = position_hash(&target, size);
+	tree->player = player;
+	if (!root_candidates(tree)) {
+		mcts_reset(tree, board, size, player);
+		return 0;
+	}
+	return 1;
+}
+
+// Crea un hijo por cada casilla vacia. Solo un hilo expande cada nodo: el que
+// cambia first_child de -1 a MCTS_EXPANDING. Los hijos se publican al final con
+// first_child (release); quien lo lee con acquire ve child_count y los hijos listos.
+// Si la arena esta llena el nodo queda como hoja. Si la tabla de transposiciones ya
+// tiene un nodo expandido de la misma posicion se comparten sus hijos (y con ellos
+// sus estadisticas) en vez de crear otros.
+static int expand(mcts_tree_t *tree, int32_t index, const position_t *pos, uint64_t hash) {
+	mcts_node_t *node = &tree->nodes[index];
+	int32_t expected = -1;
+	if (!__atomic_compare_exchange_n(&node->first_child, &expected, MCTS_EXPANDING, 0,
+		__ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+		return 0;
+	}
+	// La raiz solo crea los movimientos candidatos y no se comparte por la tabla
+	int at_root = (index == tree->root);
+	bitset_t moves;
+	int count = 0;
+	if (at_root) moves = tree->root_moves;
+	else bs_board_mask(&moves, tree->size);
+	for (int w = 0; w < BB_WORDS; w++) {
+		if (!at_root) moves.w[w] &= ~(pos->x.w[w] | pos->o.w[w]);
+		count += __builtin_popcountll(moves.w[w]);
+	}
+	int32_t twin = at_root ? -1 : tt_probe(&tree->tt, hash);
+	if (twin >= 0 && twin != index && twin < __atomic_load_n(&tree->used, __ATOMIC_RELAXED)) {
+		const mcts_node_t *other = &tree->nodes[twin];
+		int32_t shared = __atomic_load_n(&other->first_child, __ATOMIC_ACQUIRE);
+		if (shared >= 0 && other->child_count == count) {
+			node->child_count = (int16_t)count;
+			__atomic_store_n(&node->first_child, shared, __ATOMIC_RELEASE);
+			return 1;
+		}
+	}
+	int32_t first = count > 0 ? node_alloc(tree, count) : -1;
+	if (first < 0) {
+		__atomic_store_n(&node->first_child, -1, __ATOMIC_RELEASE);
+		return 0;
+	}
+	int k = 0;
+	for (int w = 0; w < BB_WORDS; w++) {
+		uint64_t bits = moves.w[w];
+		while (bits) {
+			node_init(&tree->nodes[first + k++], w * 64 + __builtin_ctzll(bits));
+			bits &= bits - 1;
+		}
+	}
+	node->child_count = (int16_t)count;
+	__atomic_store_n(&node->first_child, first, __ATOMIC_RELEASE);
+	if (!at_root) tt_store(&tree->tt, hash, index);
+	return 1;
+}
+
+// UCT: los hijos sin visitar se prueban primero. El termino de exploracion
+// C*sqrt(ln N / n) se calcula como C*sqrt(ln N) * sqrt(1/n) en precision simple.
+// Las visitas incluyen las simulaciones en curso de otros hilos (perdida virtual).
+// Con RAVE la tasa real se mezcla con la AMAF, que domina mientras hay pocas visitas;
+// un hijo sin visitas pero con datos AMAF compite con su tasa AMAF en vez de ir primero.
+static int32_t select_child(const mcts_tree_t *tree, const mcts_node_t *node, int32_t first) {
+	uint32_t parent_visits = __atomic_load_n(&node->visits, __ATOMIC_RELAXED);
+	const mcts_node_t *children = &tree->nodes[first];
+	// Con hijos compartidos por una transposicion las visitas del padre no son todas
+	// las de sus hijos; la exploracion usa la suma de los hijos si es mayor
+	if (tree->tt.entries) {
+		uint32_t sum = 0;
+		for (int k = 0; k < node->child_count; k++) sum += __atomic_load_n(&children[k].visits, __ATOMIC_RELAXED);
+		if (sum > parent_visits) parent_visits = sum;
+	}
+	float explore = (float)MCTS_UCT_C * sqrtf(logf((float)parent_visits + 1.0f));
+	float best = -1.0f;
+	int32_t choice = first;
+	for (int k = 0; k < node->child_count; k++) {
+		uint32_t visits = __atomic_load_n(&children[k].visits, __ATOMIC_RELAXED);
+		uint32_t amaf_visits = tree->rave ? __atomic_load_n(&children[k].amaf_visits, __ATOMIC_RELAXED) : 0;
+		if (visits == 0 && amaf_visits == 0) return first + k;
+		float value;
+		if (visits == 0) {
+			value = (float)__atomic_load_n(&children[k].amaf_wins, __ATOMIC_RELAXED) / (float)amaf_visits + explore;
+		} else {
+			uint32_t wins = __atomic_load_n(&children[k].wins, __ATOMIC_RELAXED);
+			float inv = 1.0f / (float)visits;
+			float rate = (float)wins * inv;
+			if (amaf_visits > 0) {
+				float beta = sqrtf((float)MCTS_RAVE_K / (3.0f * (float)visits + (float)MCTS_RAVE_K));
+				float amaf = (float)__atomic_load_n(&children[k].amaf_wins, __ATOMIC_RELAXED) / (float)amaf_visits;
+				rate = (1.0f - beta) * rate + beta * amaf;
+			}
+			value = rate + explore * sqrtf(inv);
+		}
+		if (value > best) {
+			best = value;
+			choice = first + k;
+		}
+	}
+	return choice;
+}
+
+// AMAF: los hijos de 'index' eran casillas vacias en ese nodo; los que terminaron con
+// ficha de 'turn' (el jugador en turno ahi) cuentan como si se hubieran jugado primero.
+// Son muchos contadores por simulacion, asi que se usan carga y escritura relajadas en
+// vez de sumas atomicas: entre hilos se puede perder alguna cuenta, no se corrompe.
+static void amaf_update(mcts_tree_t *tree, int32_t index, const position_t *final, char turn, int won) {
+	const mcts_node_t *node = &tree->nodes[index];
+	int32_t first = __atomic_load_n(&node->first_child, __ATOMIC_ACQUIRE);
+	if (first < 0) return;
+	const bitset_t *stones = position_color(final, turn);
+	mcts_node_t *children = &tree->nodes[first];
+	for (int k = 0; k < node->child_count; k++) {
+		if (!bs_get(stones, children[k].move)) continue;
+		uint32_t visits = __atomic_load_n(&children[k].amaf_visits, __ATOMIC_RELAXED);
+		__atomic_store_n(&children[k].amaf_visits, visits + 1, __ATOMIC_RELAXED);
+		if (won) {
+			uint32_t wins = __atomic_load_n(&children[k].amaf_wins, __ATOMIC_RELAXED);
+			__atomic_store_n(&children[k].amaf_wins, wins + 1, __ATOMIC_RELAXED);
+		}
+	}
+}
+
+// Una iteracion: seleccion, expansion, simulacion y retropropagacion.
+// La visita se suma al bajar (perdida virtual: los demas hilos ven el nodo como
+// visitado y sin victoria) y la victoria se suma al final.
+static void iterate(mcts_tree_t *tree, pcg32_random_t *rng) {
+	int32_t path[MAX_BOARD_SIZE + 1];
+	int depth = 0;
+	position_t pos = tree->pos;
+	uint64_t hash = tree->hash;
+	char turn = tree->player;
+	int32_t index = tree->root;
+	path[depth++] = index;
+	__atomic_fetch_add(&tree->nodes[index].visits, 1, __ATOMIC_RELAXED);
+	while (1) {
+		mcts_node_t *node = &tree->nodes[index];
+		int32_t first = __atomic_load_n(&node->first_child, __ATOMIC_ACQUIRE);
+		if (first < 0) {
+			if (first == MCTS_EXPANDING) break;
+			if (index != tree->root && __atomic_load_n(&node->visits, __ATOMIC_RELAXED) < MCTS_EXPAND_VISITS) break;
+			if (!expand(tree, index, &pos, hash)) break;
+			first = node->first_child;
+		}
+		index = select_child(tree, node, first);
+		__atomic_fetch_add(&tree->nodes[index].visits, 1, __ATOMIC_RELAXED);
+		position_set(&pos, tree->nodes[index].move, turn);
+		hash ^= zobrist_key(turn, tree->nodes[index].move);
+		turn = (turn == 'X') ? 'O' : 'X';
+		path[depth++] = index;
+	}
+	playout_root_t leaf;
+	position_t final;
+	playout_prepare(&leaf, &pos, tree->size, &tree->playout);
+	char winner = playout_run_final(&leaf, turn, rng, tree->rave ? &final : NULL);
+	// El nodo en path[d] lo jugo el rival de quien esta en turno a esa profundidad
+	char mover = (tree->player == 'X') ? 'O' : 'X';
+	for (int d = 0; d < depth; d++) {
+		if (winner == mover) __atomic_fetch_add(&tree->nodes[path[d]].wins, 1, __ATOMIC_RELAXED);
+		mover = (mover == 'X') ? 'O' : 'X';
+		if (tree->rave) amaf_update(tree, path[d], &final, mover, winner == mover);
+	}
+}
+
+void mcts_search(mcts_tree_t *tree, int nsim, pcg32_random_t *rng) {
+	if (tree->root < 0) return;
+	for (int i = 0; i < nsim; i++) iterate(tree, rng);
+}
+
+typedef struct {
+	mcts_tree_t *tree;
+	const search_budget_t *budget;
+	double started;
+	double deadline;
+	int64_t *claimed;
+	int64_t done;
+	int stopped;
+	pcg32_random_t rng;
+} search_thread_t;
+
+// Parada temprana, con dos reglas:
+//  - el hijo mas visitado de la raiz ya no puede ser alcanzado aunque las 'left'
+//    simulaciones que faltan fueran todas al segundo (cada simulacion suma una visita
+//    a un solo hijo); early_stop escala 'left': 1 es exacto, menos es mas agresivo
+//  - posicion decidida: con suficientes visitas, el intervalo de confianza de su tasa
+//    de victorias queda entero por encima de MCTS_SURE_RATE (ganada) o por debajo de
+//    1 - MCTS_SURE_RATE (perdida); seguir buscando ya no cambia el resultado
+static int root_decided(const mcts_tree_t *tree, int64_t left) {
+	if (tree->early_stop <= 0.0 || tree->root < 0) return 0;
+	const mcts_node_t *root = &tree->nodes[tree->root];
+	int32_t first = __atomic_load_n(&root->first_child, __ATOMIC_ACQUIRE);
+	if (first < 0 || root->child_count < 2) return 0;
+	int64_t best = 0;
+	int64_t second = 0;
+	int64_t best_wins = 0;
+	for (int k = 0; k < root->child_count; k++) {
+		int64_t visits = __atomic_load_n(&tree->nodes[first + k].visits, __ATOMIC_RELAXED);
+		if (visits > best) {
+			second = best;
+			best = visits;
+			best_wins = __atomic_load_n(&tree->nodes[first + k].wins, __ATOMIC_RELAXED);
+		} else if (visits > second) {
+			second = visits;
+		}
+	}
+	if ((double)(best - second) > tree->early_stop * (double)left) return 1;
+	if (best < MCTS_SURE_VISITS) return 0;
+	double rate = (double)best_wins / (double)best;
+	double margin = MCTS_SURE_Z * sqrt(rate * (1.0 - rate) / (double)best);
+	return rate - margin >= MCTS_SURE_RATE || rate + margin <= 1.0 - MCTS_SURE_RATE;
+}
+
+// Cada hilo toma lotes de un contador compartido hasta agotar simulaciones o tiempo.
+// Entre lotes revisa la parada temprana; con tiempo estima las simulaciones que
+// faltan con el ritmo que lleva.
+static void *search_thread(void *arg) {
+	search_thread_t *work = arg;
+	const search_budget_t *budget = work->budget;
+	while (1) {
+		double now = (budget->time_ms > 0) ? clock_ms() : 0.0;
+		if (budget->time_ms > 0 && now >= work->deadline) break;
+		int64_t batch = MCTS_BATCH;
+		int64_t start = __atomic_fetch_add(work->claimed, batch, __ATOMIC_RELAXED);
+		if (budget->nsim > 0) {
+			if (start >= budget->nsim) break;
+			if (budget->nsim - start < batch) batch = budget->nsim - start;
+		}
+		if (start > 0) {
+			int64_t left = (budget->nsim > 0) ? budget->nsim - start : INT64_MAX;
+			if (budget->time_ms > 0 && now > work->started) {
+				double rate = (double)start / (now - work->started);
+				int64_t timed = (int64_t)(rate * (work->deadline - now)) + 1;
+				if (timed < left) left = timed;
+			}
+			if (root_decided(work->tree, left)) {
+				work->stopped = 1;
+				break;
+			}
+		}
+		mcts_search(work->tree, (int)batch, &work->rng);
+		work->done += batch;
+	}
+	return NULL;
+}
+
+// Busca con el presupuesto dado usando 'threads' hilos sobre el mismo arbol.
+// Con un hilo no se crea ninguno. Regresa las simulaciones completadas; 'stopped'
+// queda en 1 si algun hilo dejo de buscar por la parada temprana.
+int64_t mcts_run(mcts_tree_t *tree, const search_budget_t *budget, int threads, pcg32_random_t *rng, int *stopped) {
+	*stopped = 0;
+	if (tree->root < 0 || (budget->nsim <= 0 && budget->time_ms <= 0)) return 0;
+	if (threads < 1) threads = 1;
+	if (threads > MCTS_MAX_THREADS) threads = MCTS_MAX_THREADS;
+	search_thread_t work[MCTS_MAX_THREADS];
+	pthread_t ids[MCTS_MAX_THREADS];
+	int64_t claimed = 0;
+	double deadline = budget->time_ms > 0 ? clock_ms() + (double)budget->time_ms : 0.0;
+	for (int t = 0; t < threads; t++) {
+		work[t].tree = tree;
+		work[t].budget = budget;
+		work[t].started = clock_ms();
+		work[t].deadline = deadline;
+		work[t].claimed = &claimed;
+		work[t].done = 0;
+		work[t].stopped = 0;
+		work[t].rng = *rng;
+		if (t > 0) pcg32_srandom_r(&work[t].rng, pcg32_random_r(rng), (uint64_t)t);
+	}
+	int started = 1;
+	for (int t = 1; t < threads; t++) {
+		if (pthread_create(&ids[t], NULL, search_thread, &work[t]) != 0) break;
+		started++;
+	}
+	search_thread(&work[0]);
+	*rng = work[0].rng;
+	int64_t done = work[0].done;
+	*stopped = work[0].stopped;
+	for (int t = 1; t < started; t++) {
+		pthread_join(ids[t], NULL);
+		done += work[t].done;
+		*stopped |= work[t].stopped;
+	}
+	return done;
+}
+
+// La arena ya no admite otra expansion completa
+int mcts_full(const mcts_tree_t *tree) {
+	return tree->capacity - tree->used < tree->size * tree->size;
+}
+
+// Estadisticas compatibles con game_move: visitas por movimiento de la raiz; las
+// casillas descartadas por el analisis de inferiores quedan en INT64_MIN
+void mcts_root_stats(const mcts_tree_t *tree, int64_t *stat) {
+	int cells = tree->size * tree->size;
+	for (int i = 0; i < cells; i++) {
+		stat[i] = bs_get(&tree->root_moves, i) ? 0 : INT64_MIN;
+	}
+	if (tree->root < 0) return;
+	const mcts_node_t *root = &tree->nodes[tree->root];
+	for (int k = 0; k < root->child_count; k++) {
+		const mcts_node_t *child = &tree->nodes[root->first_child + k];
+		stat[child->move] = child->visits;
+	}
+}
@@ -0,0 +1,84 @@
+#ifndef MCTS_H
+#define MCTS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "bitboard.h"
+#include "tt.h"
+#include "playout.h"
+
+// Memoria por defecto de la arena de nodos de cada arbol
+#define MCTS_DEFAULT_MEMORY ((size_t)64 << 20)
+// Memoria por defecto de la tabla de transposiciones de cada arbol
+#define MCTS_DEFAULT_TT_MEMORY ((size_t)16 << 20)
+// Visitas que necesita una hoja antes de expandirse
+#define MCTS_EXPAND_VISITS 2
+// Constante de exploracion de UCT (tasas de victoria en [0,1])
+#define MCTS_UCT_C 0.7
+// Simulaciones que toma cada hilo entre revisiones del presupuesto
+#define MCTS_BATCH 64
+#define MCTS_MAX_THREADS 64
+// Parada temprana por posicion decidida: visitas minimas del mejor hijo, z del
+// intervalo de confianza (99%) y tasa de victorias que se considera segura
+#define MCTS_SURE_VISITS 256
+#define MCTS_SURE_Z 2.58
+#define MCTS_SURE_RATE 0.9
+// Equivalencia de RAVE: con este numero de visitas reales el valor AMAF y el real
+// pesan lo mismo (beta = sqrt(K / (3n + K)))
+#define MCTS_RAVE_K 600
+// first_child mientras un hilo crea los hijos
+#define MCTS_EXPANDING (-2)
+
+// Nodo del arbol. Los hijos de un nodo ocupan un bloque contiguo de la arena.
+// 'wins' cuenta las victorias del jugador que hizo 'move'. visits, wins y
+// first_child se acceden con operaciones atomicas para que varios hilos compartan
+// el arbol. amaf_* cuentan las simulaciones bajo el padre en las que ese jugador
+// ocupo 'move' en cualquier momento (all-moves-as-first).
+typedef struct {
+	int32_t first_child;
+	int16_t move;
+	int16_t child_count;
+	uint32_t visits;
+	uint32_t wins;
+	uint32_t amaf_visits;
+	uint32_t amaf_wins;
+} mcts_node_t;
+
+// Arbol UCT con arena de nodos reservada una sola vez. 'keep' y 'rank' son
+// auxiliares de la compactacion al reutilizar un subarbol (un bit y un contador
+// por cada 64 nodos). Con tabla de transposiciones, dos nodos de la misma posicion
+// comparten el bloque de hijos y el arbol pasa a ser un grafo aciclico.
+// 'early_stop' es el factor de la parada temprana de mcts_run (0 la desactiva).
+// Con 'restrict_root' la raiz solo busca las casillas de 'root_only' (por ejemplo la
+// zona obligada de vc_analyze); se ignora si ninguna de ellas es candidata.
+typedef struct {
+	mcts_node_t *nodes;
+	uint64_t *keep;
+	uint32_t *rank;
+	tt_t tt;
+	uint64_t hash;
+	int32_t capacity;
+	int32_t used;
+	int32_t root;
+	int size;
+	int rave;
+	int prune;
+	double early_stop;
+	int restrict_root;
+	bitset_t root_only;
+	playout_options_t playout;
+	char player;
+	position_t pos;
+	bitset_t root_moves;
+} mcts_tree_t;
+
+int mcts_tree_init(mcts_tree_t *tree, size_t memory, size_t tt_memory);
+void mcts_tree_free(mcts_tree_t *tree);
+void mcts_reset(mcts_tree_t *tree, const char *board, int size, char player);
+int mcts_set_root(mcts_tree_t *tree, const char *board, int size, char player);
+void mcts_search(mcts_tree_t *tree, int nsim, pcg32_random_t *rng);
+int64_t mcts_run(mcts_tree_t *tree, const search_budget_t *budget, int threads, pcg32_random_t *rng, int *stopped);
+int mcts_full(const mcts_tree_t *tree);
+void mcts_root_stats(const mcts_tree_t *tree, int64_t *stat);
+
+#endif
@@ -0,0 +1,518 @@
+#include "playout.h"
+#include <string.h>
+#include <pthread.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define PLAYOUT_X86 1
+#endif
+
+// Carriles del nucleo mas ancho (AVX2: 4 partidas de 64 bits por registro)
+#define MAX_LANES 4
+
+typedef uint64_t v1u64 __attribute__((vector_size(8)));
+typedef uint64_t v2u64 __attribute__((vector_size(16)));
+typedef uint64_t v4u64 __attribute__((vector_size(32)));
+
+// Mascaras de columnas compartidas por todas las partidas de un lote
+typedef struct {
+	int size;
+	int words;
+	uint64_t first[BB_WORDS];
+	uint64_t last[BB_WORDS];
+	uint64_t not_first[BB_WORDS];
+	uint64_t not_last[BB_WORDS];
+} fill_masks_t;
+
+// Puente que pasa por una casilla: 'other' es el otro hueco y 'a', 'b' los extremos
+// (una casilla, o BRIDGE_EDGE_X / BRIDGE_EDGE_O si el extremo es un lado del tablero)
+typedef struct {
+	int16_t other;
+	int16_t a;
+	int16_t b;
+} bridge_t;
+
+#define BRIDGE_NONE -1
+#define BRIDGE_EDGE_X -2
+#define BRIDGE_EDGE_O -3
+
+// Seis puentes por casilla para cada lado de 1 a MAX_BOARD_SIDE (suma de los cuadrados)
+#define BRIDGE_CELLS (MAX_BOARD_SIDE * (MAX_BOARD_SIDE + 1) * (2 * MAX_BOARD_SIDE + 1) / 6)
+
+// Regresa una mascara con los carriles en los que X conecta
+typedef unsigned (*flood_fn_t)(const uint64_t *xs, const fill_masks_t *m);
+
+static playout_mode_t playout_mode = PLAYOUT_FILL;
+static playout_kernel_t playout_kernel = PLAYOUT_KERNEL_AUTO;
+static playout_policy_t playout_policy = PLAYOUT_POLICY_AUTO;
+static bridge_t bridge_table[BRIDGE_CELLS][6];
+static int bridge_offset[MAX_BOARD_SIDE + 1];
+static pthread_once_t bridge_once = PTHREAD_ONCE_INIT;
+
+void playout_set_mode(playout_mode_t mode) {
+	playout_mode = mode;
+}
+
+playout_mode_t playout_get_mode(void) {
+	return playout_mode;
+}
+
+int playout_parse_mode(const char *name, playout_mode_t *mode) {
+	if (!name || !mode) return 0;
+	if (strcmp(name, "fill") == 0) {
+		*mode = PLAYOUT_FILL;
+		return 1;
+	}
+	if (strcmp(name, "incremental") == 0) {
+		*mode = PLAYOUT_INCREMENTAL;
+		return 1;
+	}
+	return 0;
+}
+
+const char *playout_mode_name(playout_mode_t mode) {
+	return mode == PLAYOUT_INCREMENTAL ? "incremental" : "fill";
+}
+
+void playout_set_policy(playout_policy_t policy) {
+	playout_policy = policy;
+}
+
+playout_policy_t playout_get_policy(void) {
+	return playout_policy;
+}
+
+int playout_parse_policy(const char *name, playout_policy_t *policy) {
+	if (!name || !policy) return 0;
+	if (strcmp(name, "auto") == 0) *policy = PLAYOUT_POLICY_AUTO;
+	else if (strcmp(name, "random") == 0) *policy = PLAYOUT_POLICY_RANDOM;
+	else if (strcmp(name, "bridge") == 0) *policy = PLAYOUT_POLICY_BRIDGE;
+	else return 0;
+	return 1;
+}
+
+const char *playout_policy_name(playout_policy_t policy) {
+	switch (policy) {
+	case PLAYOUT_POLICY_RANDOM: return "random";
+	case PLAYOUT_POLICY_BRIDGE: return "bridge";
+	default: return "auto";
+	}
+}
+
+// Vecinos en orden circular: el vecino i y el i+1 son vecinos entre si, asi que los
+// huecos {c, vecino i} forman el puente entre los vecinos i-1 e i+1
+static const int ring_dx[6] = {1, 0, -1, -1, 0, 1};
+static const int ring_dy[6] = {0, 1, 1, 0, -1, -1};
+
+static int16_t bridge_end(int size, int x, int y) {
+	int out_x = (x < 0 || x >= size);
+	int out_y = (y < 0 || y >= size);
+	if (out_x && out_y) return BRIDGE_NONE;
+	if (out_x) return BRIDGE_EDGE_X;
+	if (out_y) return BRIDGE_EDGE_O;
+	return (int16_t)(y * size + x);
+}
+
+// Tablas de todos los tamanos de una vez; las comparten procesos e hilos sin escribirlas
+static void bridge_tables_init(void) {
+	int offset = 0;
+	for (int size = 1; size <= MAX_BOARD_SIDE; size++) {
+		bridge_offset[size] = offset;
+		for (int pos = 0; pos < size * size; pos++) {
+			int x = pos % size;
+			int y = pos / size;
+			for (int i = 0; i < 6; i++) {
+				bridge_t *e = &bridge_table[offset + pos][i];
+				int ox = x + ring_dx[i];
+				int oy = y + ring_dy[i];
+				e->other = BRIDGE_NONE;
+				if (ox < 0 || ox >= size || oy < 0 || oy >= size) continue;
+				e->a = bridge_end(size, x + ring_dx[(i + 5) % 6], y + ring_dy[(i + 5) % 6]);
+				e->b = bridge_end(size, x + ring_dx[(i + 1) % 6], y + ring_dy[(i + 1) % 6]);
+				if (e->a == BRIDGE_NONE || e->b == BRIDGE_NONE) continue;
+				e->other = (int16_t)(oy * size + ox);
+			}
+		}
+		offset += size * size;
+	}
+}
+
+static const bridge_t (*bridge_tables(int size))[6] {
+	pthread_once(&bridge_once, bridge_tables_init);
+	return &bridge_table[bridge_offset[size]];
+}
+
+static int bridge_owned(const bitset_t *own, int end, char player) {
+	if (end >= 0) return bs_get(own, end);
+	return end == (player == 'X' ? BRIDGE_EDGE_X : BRIDGE_EDGE_O);
+}
+
+// Hueco con el que 'player' repara un puente propio en el que el rival acaba de entrar
+// por 'pos'; -1 si no hay ninguno
+static int bridge_reply(const bridge_t (*table)[6], const position_t *b, int pos, char player) {
+	const bitset_t *own = position_color(b, player);
+	for (int i = 0; i < 6; i++) {
+		const bridge_t *e = &table[pos][i];
+		if (e->other < 0 || !bridge_owned(own, e->a, player) || !bridge_owned(own, e->b, player)) continue;
+		if (position_empty(b, e->other)) return e->other;
+	}
+	return -1;
+}
+
+static int kernel_supported(playout_kernel_t kernel) {
+	switch (kernel) {
+	case PLAYOUT_KERNEL_SCALAR:
+		return 1;
+#ifdef PLAYOUT_X86
+	case PLAYOUT_KERNEL_SSE2:
+		return __builtin_cpu_supports("sse2");
+	case PLAYOUT_KERNEL_AVX2:
+		return __builtin_cpu_supports("avx2");
+#endif
+	default:
+		return 0;
+	}
+}
+
+// Fija el nucleo de los lotes; regresa 0 si la CPU no lo soporta
+int playout_set_kernel(playout_kernel_t kernel) {
+	if (kernel != PLAYOUT_KERNEL_AUTO && !kernel_supported(kernel)) return 0;
+	playout_kernel = kernel;
+	return 1;
+}
+
+// Nucleo que se usa realmente (AUTO ya resuelto por CPUID)
+playout_kernel_t playout_get_kernel(void) {
+	playout_kernel_t active = PLAYOUT_KERNEL_SCALAR;
+	playout_resolve_kernel(playout_kernel, &active);
+	return active;
+}
+
+// Resuelve AUTO al mejor nucleo de la CPU; regresa 0 si 'kernel' no esta soportado
+int playout_resolve_kernel(playout_kernel_t kernel, playout_kernel_t *active) {
+	if (kernel == PLAYOUT_KERNEL_AUTO) {
+		if (kernel_supported(PLAYOUT_KERNEL_AVX2)) *active = PLAYOUT_KERNEL_AVX2;
+		else if (kernel_supported(PLAYOUT_KERNEL_SSE2)) *active = PLAYOUT_KERNEL_SSE2;
+		else *active = PLAYOUT_KERNEL_SCALAR;
+		return 1;
+	}
+	if (!kernel_supported(kernel)) return 0;
+	*active = kernel;
+	return 1;
+}
+
+// Opciones de las simulaciones del proceso (las de las banderas de la linea de comandos)
+void playout_get_options(playout_options_t *options) {
+	options->mode = playout_mode;
+	options->policy = playout_policy;
+	options->kernel = playout_get_kernel();
+}
+
+int playout_parse_kernel(const char *name, playout_kernel_t *kernel) {
+	if (!name || !kernel) return 0;
+	if (strcmp(name, "auto") == 0) *kernel = PLAYOUT_KERNEL_AUTO;
+	else if (strcmp(name, "scalar") == 0) *kernel = PLAYOUT_KERNEL_SCALAR;
+	else if (strcmp(name, "sse2") == 0) *kernel = PLAYOUT_KERNEL_SSE2;
+	else if (strcmp(name, "avx2") == 0) *kernel = PLAYOUT_KERNEL_AVX2;
+	else return 0;
+	return 1;
+}
+
+const char *playout_kernel_name(playout_kernel_t kernel) {
+	switch (kernel) {
+	case PLAYOUT_KERNEL_SCALAR: return "scalar";
+	case PLAYOUT_KERNEL_SSE2: return "sse2";
+	case PLAYOUT_KERNEL_AVX2: return "avx2";
+	default: return "auto";
+	}
+}
+
+// El union-find solo lo necesita el modo incremental. Con options NULL se usan las
+// opciones del proceso; las simulaciones de la raiz (y sus copias) siguen las suyas.
+void playout_prepare(playout_root_t *root, const position_t *p, int size, const playout_options_t *options) {
+	if (options) root->options = *options;
+	else playout_get_options(&root->options);
+	root->size = size;
+	root->pos = *p;
+	root->empty_count = 0;
+	bs_board_mask(&root->empty_mask, size);
+	for (int w = 0; w < BB_WORDS; w++) {
+		uint64_t bits = root->empty_mask.w[w] & ~(p->x.w[w] | p->o.w[w]);
+		root->empty_mask.w[w] = bits;
+		while (bits) {
+			root->empty[root->empty_count++] = (int16_t)(w * 64 + __builtin_ctzll(bits));
+			bits &= bits - 1;
+		}
+	}
+	if (root->options.mode == PLAYOUT_INCREMENTAL) {
+		uf_from_position(&root->conn, p, size);
+	}
+}
+
+void playout_play(playout_root_t *root, int pos, char player) {
+	position_set(&root->pos, pos, player);
+	bs_reset(&root->empty_mask, pos);
+	for (int i = 0; i < root->empty_count; i++) {
+		if (root->empty[i] == pos) {
+			root->empty[i] = root->empty[--root->empty_count];
+			break;
+		}
+	}
+	if (root->options.mode == PLAYOUT_INCREMENTAL) {
+		uf_place(&root->conn, &root->pos, pos, player);
+	}
+}
+
+// Llenado jugada a jugada con la politica de puentes: el orden sale de un barajado y,
+// cuando el rival entra en un puente de quien mueve, la siguiente jugada es el otro
+// hueco (se intercambia con la que tocaba en el barajado)
+static void bridge_fill(const playout_root_t *root, char player, pcg32_random_t *rng, position_t *b) {
+	const bridge_t (*table)[6] = bridge_tables(root->size);
+	int16_t cells[MAX_BOARD_SIZE];
+	int16_t index[MAX_BOARD_SIZE];
+	int n = root->empty_count;
+	char turn = player;
+	int reply = -1;
+	*b = root->pos;
+	memcpy(cells, root->empty, (size_t)n * sizeof(cells[0]));
+	for (int i = 0; i < n; i++) index[cells[i]] = (int16_t)i;
+	for (int i = 0; i < n; i++) {
+		int j = (reply >= 0) ? index[reply] : i + (int)pcg32_boundedrand_r(rng, (uint32_t)(n - i));
+		int16_t t = cells[i];
+		cells[i] = cells[j];
+		cells[j] = t;
+		index[cells[i]] = (int16_t)i;
+		index[cells[j]] = (int16_t)j;
+		position_set(b, cells[i], turn);
+		turn = (turn == 'X') ? 'O' : 'X';
+		reply = bridge_reply(table, b, cells[i], turn);
+	}
+}
+
+// Barajado parcial de Fisher-Yates: el jugador en turno recibe ceil(n/2) casillas al azar
+// y el rival todas las demas. Una sola evaluacion de conectividad al final.
+static char playout_fill(const playout_root_t *root, char player, pcg32_random_t *rng, position_t *final) {
+	if (root->options.policy == PLAYOUT_POLICY_BRIDGE) {
+		position_t b;
+		bridge_fill(root, player, rng, &b);
+		if (final) *final = b;
+		return position_has_connection(&b, root->size, 'X') ? 'X' : 'O';
+	}
+	int16_t cells[MAX_BOARD_SIZE];
+	int n = root->empty_count;
+	int mine = (n + 1) / 2;
+	position_t b = root->pos;
+	bitset_t chosen;
+	memcpy(cells, root->empty, (size_t)n * sizeof(cells[0]));
+	bs_clear(&chosen);
+	for (int i = 0; i < mine; i++) {
+		int j = i + (int)pcg32_boundedrand_r(rng, (uint32_t)(n - i));
+		int16_t t = cells[i];
+		cells[i] = cells[j];
+		cells[j] = t;
+		bs_set(&chosen, cells[i]);
+	}
+	bitset_t *own = (player == 'X') ? &b.x : &b.o;
+	bitset_t *rival = (player == 'X') ? &b.o : &b.x;
+	for (int w = 0; w < BB_WORDS; w++) {
+		own->w[w] |= chosen.w[w];
+		rival->w[w] |= root->empty_mask.w[w] & ~chosen.w[w];
+	}
+	if (final) *final = b;
+	return position_has_connection(&b, root->size, 'X') ? 'X' : 'O';
+}
+
+// Juega en el orden de un barajado y prueba la conexion de quien movio tras cada ficha.
+// Con la politica de puentes responde como bridge_fill.
+static char playout_incremental(const playout_root_t *root, char player, pcg32_random_t *rng, position_t *final) {
+	const bridge_t (*table)[6] = (root->options.policy == PLAYOUT_POLICY_BRIDGE) ? bridge_tables(root->size) : NULL;
+	int16_t cells[MAX_BOARD_SIZE];
+	int16_t index[MAX_BOARD_SIZE];
+	int n = root->empty_count;
+	char last = (player == 'X') ? 'O' : 'X';
+	char turn = player;
+	int reply = -1;
+	position_t b = root->pos;
+	uf_t conn;
+	uf_copy(&conn, &root->conn);
+	char winner = 0;
+	if (uf_connected(&conn, last)) winner = last;
+	memcpy(cells, root->empty, (size_t)n * sizeof(cells[0]));
+	if (table) {
+		for (int i = 0; i < n; i++) index[cells[i]] = (int16_t)i;
+	}
+	for (int i = 0; i < n && !winner; i++) {
+		int j = (reply >= 0) ? index[reply] : i + (int)pcg32_boundedrand_r(rng, (uint32_t)(n - i));
+		int16_t t = cells[i];
+		cells[i] = cells[j];
+		cells[j] = t;
+		position_set(&b, cells[i], turn);
+		if (uf_place(&conn, &b, cells[i], turn)) winner = turn;
+		turn = (turn == 'X') ? 'O' : 'X';
+		if (table) {
+			index[cells[i]] = (int16_t)i;
+			index[cells[j]] = (int16_t)j;
+			reply = bridge_reply(table, &b, cells[i], turn);
+		}
+	}
+	if (!winner) winner = uf_connected(&conn, 'X') ? 'X' : 'O';
+	if (final) *final = b;
+	return winner;
+}
+
+// Simula una partida desde la raiz con 'player' en turno y regresa el ganador
+char playout_run(const playout_root_t *root, char player, pcg32_random_t *rng) {
+	return playout_run_final(root, player, rng, NULL);
+}
+
+// Igual que playout_run, y deja en 'final' las fichas de cada jugador al terminar
+// (para las estadisticas AMAF); 'final' puede ser NULL
+char playout_run_final(const playout_root_t *root, char player, pcg32_random_t *rng, position_t *final) {
+	if (root->options.mode == PLAYOUT_INCREMENTAL) return playout_incremental(root, player, rng, final);
+	return playout_fill(root, player, rng, final);
+}
+
+static void fill_masks_init(fill_masks_t *m, int size) {
+	bitset_t board;
+	bs_board_mask(&board, size);
+	memset(m, 0, sizeof(*m));
+	m->size = size;
+	m->words = (size * size + 63) / 64;
+	for (int y = 0; y < size; y++) {
+		int a = y * size;
+		int b = y * size + size - 1;
+		m->first[a >> 6] |= (uint64_t)1 << (a & 63);
+		m->last[b >> 6] |= (uint64_t)1 << (b & 63);
+	}
+	for (int w = 0; w < BB_WORDS; w++) {
+		m->not_first[w] = board.w[w] & ~m->first[w];
+		m->not_last[w] = board.w[w] & ~m->last[w];
+	}
+}
+
+// Relleno por desplazamientos de LANES tableros intercalados (palabra w del carril l
+// en xs[w * LANES + l]): el conjunto alcanzable desde la columna 0 crece con los seis
+// vecinos hasta un punto fijo. T1 = {x, x-1} y T2 = {x, x+1} de cada fila; T1 bajado
+// una fila y T2 subido una fila completan los vecinos hexagonales.
+#define DEFINE_FLOOD(NAME, VEC, LANES, ATTR) \
+ATTR static unsigned NAME(const uint64_t *xs, const fill_masks_t *m) { \
+	VEC stones[BB_WORDS], reach[BB_WORDS], t1[BB_WORDS], t2[BB_WORDS]; \
+	const VEC zero = {0}; \
+	int nw = m->words; \
+	int s = m->size; \
+	for (int w = 0; w < nw; w++) { \
+		memcpy(&stones[w], xs + w * LANES, sizeof(VEC)); \
+		reach[w] = stones[w] & m->first[w]; \
+	} \
+	while (1) { \
+		VEC changed = zero; \
+		for (int w = 0; w < nw; w++) { \
+			VEC r = reach[w]; \
+			VEC lo = (w > 0) ? reach[w - 1] : zero; \
+			VEC hi = (w + 1 < nw) ? reach[w + 1] : zero; \
+			t1[w] = r | (((r >> 1) | (hi << 63)) & m->not_last[w]); \
+			t2[w] = r | (((r << 1) | (lo >> 63)) & m->not_first[w]); \
+		} \
+		for (int w = 0; w < nw; w++) { \
+			VEC down = t1[w] << s; \
+			VEC up = t2[w] >> s; \
+			if (w > 0) down |= t1[w - 1] >> (64 - s); \
+			if (w + 1 < nw) up |= t2[w + 1] << (64 - s); \
+			VEC next = (t1[w] | t2[w] | down | up) & stones[w]; \
+			changed |= next ^ reach[w]; \
+			reach[w] = next; \
+		} \
+		uint64_t any = 0; \
+		for (int l = 0; l < LANES; l++) any |= changed[l]; \
+		if (!any) break; \
+	} \
+	VEC hit = zero; \
+	for (int w = 0; w < nw; w++) hit |= reach[w] & m->last[w]; \
+	unsigned lanes = 0; \
+	for (int l = 0; l < LANES; l++) { \
+		if (hit[l]) lanes |= 1u << l; \
+	} \
+	return lanes; \
+}
+
+DEFINE_FLOOD(flood_scalar, v1u64, 1, )
+#ifdef PLAYOUT_X86
+DEFINE_FLOOD(flood_sse2, v2u64, 2, __attribute__((target("sse2"))))
+DEFINE_FLOOD(flood_avx2, v4u64, 4, __attribute__((target("avx2"))))
+#endif
+
+// Reparte las casillas vacias de una partida: el rival de quien mueve recibe floor(n/2)
+// al azar. 'cells' es cualquier permutacion de las vacias y se reutiliza entre carriles:
+// con indices sin sesgo (pcg32_boundedrand_r) el barajado parcial sigue siendo uniforme.
+static void fill_lane(const playout_root_t *root, char player, int16_t *cells, uint64_t *xs, int stride, pcg32_random_t *rng) {
+	int n = root->empty_count;
+	int theirs = n / 2;
+	int words = (root->size * root->size + 63) / 64;
+	bitset_t chosen;
+	bs_clear(&chosen);
+	for (int i = 0; i < theirs; i++) {
+		int j = i + (int)pcg32_boundedrand_r(rng, (uint32_t)(n - i));
+		int16_t t = cells[i];
+		cells[i] = cells[j];
+		cells[j] = t;
+		bs_set(&chosen, cells[i]);
+	}
+	for (int w = 0; w < words; w++) {
+		uint64_t own = root->empty_mask.w[w] & ~chosen.w[w];
+		xs[w * stride] = root->pos.x.w[w] | (player == 'X' ? own : chosen.w[w]);
+	}
+}
+
+// Simula 'count' partidas desde la raiz con 'player' en turno y regresa cuantas gana
+// 'player'. En modo fill las partidas se evaluan de LANES en LANES con el nucleo elegido;
+// solo la inundacion es vectorial: con la politica de puentes cada carril se llena
+// ficha a ficha con bridge_fill y el lote cuesta casi lo mismo que simular uno a uno.
+int playout_run_batch(const playout_root_t *root, char player, int count, pcg32_random_t *rng) {
+	if (count <= 0) return 0;
+	if (root->options.mode == PLAYOUT_INCREMENTAL) {
+		int wins = 0;
+		for (int i = 0; i < count; i++) {
+			if (playout_incremental(root, player, rng, NULL) == player) wins++;
+		}
+		return wins;
+	}
+	flood_fn_t flood = flood_scalar;
+	int lanes = 1;
+#ifdef PLAYOUT_X86
+	switch (root->options.kernel) {
+	case PLAYOUT_KERNEL_AVX2:
+		flood = flood_avx2;
+		lanes = 4;
+		break;
+	case PLAYOUT_KERNEL_SSE2:
+		flood = flood_sse2;
+		lanes = 2;
+		break;
+	default:
+		break;
+	}
+#endif
+	fill_masks_t masks;
+	int16_t cells[MAX_BOARD_SIZE];
+	uint64_t xs[BB_WORDS * MAX_LANES] __attribute__((aligned(32)));
+	int x_wins = 0;
+	fill_masks_init(&masks, root->size);
+	memcpy(cells, root->empty, (size_t)root->empty_count * sizeof(cells[0]));
+	memset(xs, 0, sizeof(xs));
+	for (int done = 0; done < count; done += lanes) {
+		int active = count - done < lanes ? count - done : lanes;
+		for (int l = 0; l < active; l++) {
+			if (root->options.policy == PLAYOUT_POLICY_BRIDGE) {
+				position_t b;
+				bridge_fill(root, player, rng, &b);
+				for (int w = 0; w < masks.words; w++) xs[w * lanes + l] = b.x.w[w];
+			} else {
+				fill_lane(root, player, cells, xs + l, lanes, rng);
+			}
+		}
+		for (int l = active; l < lanes; l++) {
+			for (int w = 0; w < masks.words; w++) xs[w * lanes + l] = 0;
+		}
+		x_wins += __builtin_popcount(flood(xs, &masks) & ((1u << active) - 1));
+	}
+	return player == 'X' ? x_wins : count - x_wins;
+}
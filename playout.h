@@ -0,0 +1,77 @@
+#ifndef PLAYOUT_H
+#define PLAYOUT_H
+
+#include <stdint.h>
+#include "bitboard.h"
+#include "unionfind.h"
+
+// Modos de simulacion:
+//  PLAYOUT_FILL: llena todas las casillas vacias en orden aleatorio y evalua una sola vez
+//               (Hex no tiene empates, el tablero lleno siempre tiene ganador)
+//  PLAYOUT_INCREMENTAL: juega movimiento a movimiento y se detiene al detectar la conexion
+typedef enum {
+	PLAYOUT_FILL,
+	PLAYOUT_INCREMENTAL
+} playout_mode_t;
+
+// Nucleo de las simulaciones por lotes (solo modo fill): varias partidas avanzan a la
+// vez, una por carril del registro vectorial. AUTO elige el mejor que tenga la CPU.
+typedef enum {
+	PLAYOUT_KERNEL_AUTO,
+	PLAYOUT_KERNEL_SCALAR,
+	PLAYOUT_KERNEL_SSE2,
+	PLAYOUT_KERNEL_AVX2
+} playout_kernel_t;
+
+// Politica de las simulaciones:
+//  PLAYOUT_POLICY_AUTO: la elige el motor (puentes en UCT, al azar en el plano);
+//                      en las simulaciones equivale a RANDOM
+//  PLAYOUT_POLICY_RANDOM: cada jugada es una casilla vacia al azar
+//  PLAYOUT_POLICY_BRIDGE: si el rival acaba de entrar en un puente propio (o en un
+//                        puente al lado propio), se responde en el otro hueco
+typedef enum {
+	PLAYOUT_POLICY_AUTO,
+	PLAYOUT_POLICY_RANDOM,
+	PLAYOUT_POLICY_BRIDGE
+} playout_policy_t;
+
+// Opciones de las simulaciones de una raiz; kernel ya resuelto (nunca AUTO)
+typedef struct {
+	playout_mode_t mode;
+	playout_policy_t policy;
+	playout_kernel_t kernel;
+} playout_options_t;
+
+// Posicion de partida de las simulaciones con su lista de casillas vacias precalculada
+typedef struct {
+	playout_options_t options;
+	int size;
+	position_t pos;
+	bitset_t empty_mask;
+	int16_t empty[MAX_BOARD_SIZE];
+	int empty_count;
+	uf_t conn;
+} playout_root_t;
+
+void playout_set_mode(playout_mode_t mode);
+playout_mode_t playout_get_mode(void);
+int playout_parse_mode(const char *name, playout_mode_t *mode);
+const char *playout_mode_name(playout_mode_t mode);
+void playout_set_policy(playout_policy_t policy);
+playout_policy_t playout_get_policy(void);
+int playout_parse_policy(const char *name, playout_policy_t *policy);
+const char *playout_policy_name(playout_policy_t policy);
+int playout_set_kernel(playout_kernel_t kernel);
+playout_kernel_t playout_get_kernel(void);
+int playout_parse_kernel(const char *name, playout_kernel_t *kernel);
+const char *playout_kernel_name(playout_kernel_t kernel);
+int playout_resolve_kernel(playout_kernel_t kernel, playout_kernel_t *active);
+void playout_get_options(playout_options_t *options);
+
+void playout_prepare(playout_root_t *root, const position_t *p, int size, const playout_options_t *options);
+void playout_play(playout_root_t *root, int pos, char player);
+char playout_run(const playout_root_t *root, char player, pcg32_random_t *rng);
+char playout_run_final(const playout_root_t *root, char player, pcg32_random_t *rng, position_t *final);
+int playout_run_batch(const playout_root_t *root, char player, int count, pcg32_random_t *rng);
+
+#endif
@@ -0,0 +1,275 @@
+#include "protocol.h"
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/uio.h>
+
+#define REQUEST_FIXED 13
+#define PACKED_BOARD_MAX ((MAX_BOARD_SIZE + 3) / 4)
+#define PACKED_ROOT_MAX ((MAX_BOARD_SIZE + 7) / 8)
+#define STATS_FIXED 12
+
+ssize_t read_full(int fd, void *buf, size_t count) {
+	size_t left = count;
+	char *ptr = buf;
+	while (left > 0) {
+		ssize_t r = read(fd, ptr, left);
+		if (r < 0) {
+			if (errno == EINTR) continue;
+			return -1;
+		}
+		if (r == 0) return count - left;
+		left -= (size_t)r;
+		ptr += r;
+	}
+	return (ssize_t)count;
+}
+
+ssize_t write_full(int fd, const void *buf, size_t count) {
+	size_t left = count;
+	const char *ptr = buf;
+	while (left > 0) {
+		ssize_t r = write(fd, ptr, left);
+		if (r < 0) {
+			if (errno == EINTR) continue;
+			return -1;
+		}
+		left -= (size_t)r;
+		ptr += r;
+	}
+	return (ssize_t)count;
+}
+
+// Escribe todos los segmentos con writev, reintentando escrituras parciales
+static int writev_full(int fd, struct iovec *iov, int count) {
+	while (count > 0) {
+		ssize_t r = writev(fd, iov, count);
+		if (r < 0) {
+			if (errno == EINTR) continue;
+			return -1;
+		}
+		while (count > 0 && (size_t)r >= iov->iov_len) {
+			r -= (ssize_t)iov->iov_len;
+			iov++;
+			count--;
+		}
+		if (count > 0) {
+			iov->iov_base = (char *)iov->iov_base + r;
+			iov->iov_len -= (size_t)r;
+		}
+	}
+	return 0;
+}
+
+static void header_init(proto_header_t *header, int cmd, int size, uint8_t flags, size_t length) {
+	header->magic = PROTO_MAGIC;
+	header->version = PROTO_VERSION;
+	header->cmd = (uint8_t)cmd;
+	header->size = (uint8_t)size;
+	header->flags = flags;
+	header->reserved = 0;
+	header->length = (uint32_t)length;
+}
+
+static int read_header(int fd, proto_header_t *header) {
+	if (read_full(fd, header, sizeof(*header)) != (ssize_t)sizeof(*header)) return -1;
+	if (header->magic != PROTO_MAGIC || header->version != PROTO_VERSION) return -1;
+	if (header->size > MAX_BOARD_SIDE) return -1;
+	return 0;
+}
+
+static size_t pack_board(uint8_t *out, const char *board, int cells) {
+	size_t bytes = (size_t)(cells + 3) / 4;
+	memset(out, 0, bytes);
+	for (int i = 0; i < cells; i++) {
+		uint8_t code = (board[i] == 'X') ? 1 : (board[i] == 'O') ? 2 : 0;
+		out[i >> 2] |= (uint8_t)(code << ((i & 3) * 2));
+	}
+	return bytes;
+}
+
+static void unpack_board(char *board, const uint8_t *in, int cells) {
+	for (int i = 0; i < cells; i++) {
+		uint8_t code = (in[i >> 2] >> ((i & 3) * 2)) & 3u;
+		board[i] = (code == 1) ? 'X' : (code == 2) ? 'O' : '+';
+	}
+}
+
+static int free_cells(const char *board, int cells) {
+	int count = 0;
+	for (int i = 0; i < cells; i++) count += (board[i] == '+');
+	return count;
+}
+
+// Un bit por casilla libre, en orden: 1 si la raiz puede jugarla
+static size_t pack_root(uint8_t *out, const char *board, int cells, const bitset_t *allowed) {
+	size_t bytes = (size_t)(free_cells(board, cells) + 7) / 8;
+	int k = 0;
+	memset(out, 0, bytes);
+	for (int i = 0; i < cells; i++) {
+		if (board[i] != '+') continue;
+		if (bs_get(allowed, i)) out[k >> 3] |= (uint8_t)(1u << (k & 7));
+		k++;
+	}
+	return bytes;
+}
+
+static void unpack_root(bitset_t *allowed, const uint8_t *in, const char *board, int cells) {
+	int k = 0;
+	memset(allowed, 0, sizeof(*allowed));
+	for (int i = 0; i < cells; i++) {
+		if (board[i] != '+') continue;
+		if ((in[k >> 3] >> (k & 7)) & 1u) bs_set(allowed, i);
+		k++;
+	}
+}
+
+int proto_send_request(int fd, const worker_request_t *request) {
+	proto_header_t header;
+	uint8_t fixed[REQUEST_FIXED];
+	uint8_t packed[PACKED_BOARD_MAX];
+	int32_t counts[MAX_BOARD_SIZE];
+	uint8_t root[PACKED_ROOT_MAX];
+	int32_t fields[3] = {request->job, request->nsim, request->time_ms};
+	size_t board_bytes = 0;
+	size_t count_bytes = 0;
+	size_t root_bytes = 0;
+	uint8_t flags = 0;
+	if (request->cmd != WORKER_CMD_STOP) {
+		memcpy(fixed, fields, sizeof(fields));
+		fixed[12] = (uint8_t)request->player;
+		board_bytes = pack_board(packed, request->board, request->size * request->size);
+	}
+	if (request->cmd == WORKER_CMD_EVAL) {
+		int count = 0;
+		for (int i = 0; i < request->size * request->size; i++) {
+			if (request->board[i] == '+') counts[count++] = request->counts[i];
+		}
+		count_bytes = (size_t)count * sizeof(int32_t);
+	}
+	if (request->cmd == WORKER_CMD_SEARCH && request->restrict_root) {
+		root_bytes = pack_root(root, request->board, request->size * request->size, &request->root_only);
+		flags |= PROTO_FLAG_ROOT;
+	}
+	size_t length = (request->cmd != WORKER_CMD_STOP) ? REQUEST_FIXED + board_bytes + count_bytes + root_bytes : 0;
+	header_init(&header, request->cmd, request->size, flags, length);
+	struct iovec iov[4] = {
+		{&header, sizeof(header)},
+		{fixed, length ? REQUEST_FIXED : 0},
+		{packed, board_bytes},
+		{count_bytes ? (void *)counts : (void *)root, count_bytes ? count_bytes : root_bytes}
+	};
+	return writev_full(fd, iov, length ? ((count_bytes || root_bytes) ? 4 : 3) : 1);
+}
+
+int proto_recv_request(int fd, worker_request_t *request) {
+	proto_header_t header;
+	uint8_t payload[REQUEST_FIXED + PACKED_BOARD_MAX + MAX_BOARD_SIZE * sizeof(int32_t)];
+	if (read_header(fd, &header) != 0) return -1;
+	if (header.length > sizeof(payload)) return -1;
+	if (read_full(fd, payload, header.length) != (ssize_t)header.length) return -1;
+	memset(request, 0, sizeof(*request));
+	request->cmd = header.cmd;
+	request->size = header.size;
+	if (header.cmd == WORKER_CMD_STOP) return 0;
+	int cells = request->size * request->size;
+	size_t board_bytes = (size_t)(cells + 3) / 4;
+	if (header.length < REQUEST_FIXED + board_bytes) return -1;
+	int32_t fields[3];
+	memcpy(fields, payload, sizeof(fields));
+	request->job = fields[0];
+	request->nsim = fields[1];
+	request->time_ms = fields[2];
+	request->player = (char)payload[12];
+	unpack_board(request->board, payload + REQUEST_FIXED, cells);
+	size_t count_bytes = 0;
+	if (header.cmd == WORKER_CMD_EVAL) {
+		const uint8_t *ptr = payload + REQUEST_FIXED + board_bytes;
+		for (int i = 0; i < cells; i++) {
+			if (request->board[i] != '+') continue;
+			memcpy(&request->counts[i], ptr + count_bytes, sizeof(int32_t));
+			count_bytes += sizeof(int32_t);
+		}
+	}
+	size_t root_bytes = 0;
+	if (header.cmd == WORKER_CMD_SEARCH && (header.flags & PROTO_FLAG_ROOT)) {
+		size_t offset = REQUEST_FIXED + board_bytes;
+		root_bytes = (size_t)(free_cells(request->board, cells) + 7) / 8;
+		if (header.length < offset + root_bytes) return -1;
+		unpack_root(&request->root_only, payload + offset, request->board, cells);
+		request->restrict_root = 1;
+	}
+	return header.length == REQUEST_FIXED + board_bytes + count_bytes + root_bytes ? 0 : -1;
+}
+
+// Envia solo los contadores de las casillas libres; con stats == NULL es un aviso.
+// Una casilla libre descartada por el motor (INT64_MIN) viaja como INT32_MIN.
+int proto_send_stats(int fd, const char *board, int size, int job, int64_t playouts, const int64_t *stats) {
+	proto_header_t header;
+	uint8_t fixed[STATS_FIXED];
+	int64_t wide[MAX_BOARD_SIZE];
+	int32_t narrow[MAX_BOARD_SIZE];
+	int32_t job32 = job;
+	int count = 0;
+	int fits = 1;
+	uint8_t flags = 0;
+	memcpy(fixed, &job32, sizeof(job32));
+	memcpy(fixed + 4, &playouts, sizeof(playouts));
+	if (stats) {
+		for (int i = 0; i < size * size; i++) {
+			if (board[i] != '+') continue;
+			wide[count] = stats[i];
+			if (stats[i] != INT64_MIN && (stats[i] <= INT32_MIN || stats[i] > INT32_MAX)) fits = 0;
+			count++;
+		}
+		if (fits) {
+			for (int k = 0; k < count; k++) narrow[k] = wide[k] == INT64_MIN ? INT32_MIN : (int32_t)wide[k];
+			flags |= PROTO_FLAG_STATS32;
+		}
+	} else {
+		flags |= PROTO_FLAG_SIGNAL;
+	}
+	size_t stats_bytes = (size_t)count * (fits ? sizeof(int32_t) : sizeof(int64_t));
+	header_init(&header, WORKER_CMD_SEARCH, size, flags, STATS_FIXED + stats_bytes);
+	struct iovec iov[3] = {
+		{&header, sizeof(header)},
+		{fixed, STATS_FIXED},
+		{fits ? (void *)narrow : (void *)wide, stats_bytes}
+	};
+	return writev_full(fd, iov, stats_bytes ? 3 : 2);
+}
+
+// Recibe resultados del tablero 'board'; las casillas ocupadas quedan en INT64_MIN.
+// Con stats == NULL se espera un aviso.
+int proto_recv_stats(int fd, const char *board, int size, int *job, int64_t *playouts, int64_t *stats) {
+	proto_header_t header;
+	uint8_t payload[STATS_FIXED + MAX_BOARD_SIZE * sizeof(int64_t)];
+	if (read_header(fd, &header) != 0) return -1;
+	if (header.length > sizeof(payload) || header.size != size) return -1;
+	if (read_full(fd, payload, header.length) != (ssize_t)header.length) return -1;
+	int32_t job32;
+	memcpy(&job32, payload, sizeof(job32));
+	memcpy(playouts, payload + 4, sizeof(*playouts));
+	*job = job32;
+	if (!stats) return (header.flags & PROTO_FLAG_SIGNAL) ? 0 : -1;
+	if (header.flags & PROTO_FLAG_SIGNAL) return -1;
+	size_t width = (header.flags & PROTO_FLAG_STATS32) ? sizeof(int32_t) : sizeof(int64_t);
+	const uint8_t *ptr = payload + STATS_FIXED;
+	const uint8_t *end = payload + header.length;
+	for (int i = 0; i < size * size; i++) {
+		if (board[i] != '+') {
+			stats[i] = INT64_MIN;
+			continue;
+		}
+		if (ptr + width > end) return -1;
+		if (width == sizeof(int32_t)) {
+			int32_t v;
+			memcpy(&v, ptr, sizeof(v));
+			stats[i] = v == INT32_MIN ? INT64_MIN : v;
+		} else {
+			memcpy(&stats[i], ptr, sizeof(stats[i]));
+		}
+		ptr += width;
+	}
+	return ptr == end ? 0 : -1;
+}
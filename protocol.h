@@ -0,0 +1,65 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <stdint.h>
+#include <sys/types.h>
+#include "hex.h"
+#include "bitboard.h"
+
+// Protocolo entre el proceso principal y los trabajadores. Cada mensaje es una
+// cabecera fija seguida de 'length' bytes de carga que dependen del tamano real del
+// tablero:
+//   peticion:  job, nsim, time_ms (int32), jugador, y las casillas a 2 bits cada una;
+//              una evaluacion agrega las simulaciones (int32) de cada casilla libre;
+//              con PROTO_FLAG_ROOT una busqueda agrega un bit por casilla libre con
+//              las jugadas permitidas en la raiz
+//   resultado: job (int32), simulaciones (int64) y un contador por casilla libre del
+//              tablero de la peticion, de 32 bits si todos caben (PROTO_FLAG_STATS32)
+//   aviso:     job y simulaciones; los contadores estan en memoria compartida
+#define PROTO_MAGIC 0x4858u
+#define PROTO_VERSION 1
+#define PROTO_FLAG_STATS32 0x01u
+#define PROTO_FLAG_SIGNAL 0x02u
+#define PROTO_FLAG_ROOT 0x04u
+
+enum {
+	WORKER_CMD_STOP = 0,
+	WORKER_CMD_SEARCH = 1,
+	WORKER_CMD_PONDER = 2,
+	WORKER_CMD_EVAL = 3
+};
+
+typedef struct {
+	uint16_t magic;
+	uint8_t version;
+	uint8_t cmd;
+	uint8_t size;
+	uint8_t flags;
+	uint16_t reserved;
+	uint32_t length;
+} proto_header_t;
+
+// Peticion ya decodificada; 'counts' solo lo usa WORKER_CMD_EVAL y 'root_only'
+// (si 'restrict_root') solo WORKER_CMD_SEARCH
+typedef struct {
+	int cmd;
+	int size;
+	int job;
+	int nsim;
+	int time_ms;
+	char player;
+	char board[MAX_BOARD_SIZE];
+	int32_t counts[MAX_BOARD_SIZE];
+	int restrict_root;
+	bitset_t root_only;
+} worker_request_t;
+
+ssize_t read_full(int fd, void *buf, size_t count);
+ssize_t write_full(int fd, const void *buf, size_t count);
+
+int proto_send_request(int fd, const worker_request_t *request);
+int proto_recv_request(int fd, worker_request_t *request);
+int proto_send_stats(int fd, const char *board, int size, int job, int64_t playouts, const int64_t *stats);
+int proto_recv_stats(int fd, const char *board, int size, int *job, int64_t *playouts, int64_t *stats);
+
+#endif
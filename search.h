@@ -0,0 +1,35 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include "hex.h"
+#include "mcts.h"
+#include "playout.h"
+
+// Estado completo de un motor de busqueda: opciones, arbol UCT y generador. Las
+// funciones game_* de hex.c trabajan sobre el del proceso; cada motor de libhexcore
+// (hexcore.c) tiene el suyo, asi que varios pueden buscar a la vez en un proceso.
+// 'stopped' queda en 1 si la ultima busqueda termino por la parada temprana.
+// Con 'restrict_root' la raiz solo considera las casillas de 'root_only' (ambos motores).
+typedef struct {
+	engine_t engine;
+	alloc_t alloc;
+	int threads;
+	int rave;
+	int prune;
+	double early_stop;
+	int restrict_root;
+	bitset_t root_only;
+	size_t tree_memory;
+	size_t tt_memory;
+	playout_options_t playout;
+	pcg32_random_t rng;
+	mcts_tree_t tree;
+	int stopped;
+} search_ctx_t;
+
+void search_ctx_init(search_ctx_t *ctx);
+void search_ctx_free(search_ctx_t *ctx);
+int64_t search_ctx_run(search_ctx_t *ctx, const char *board, int size, char player, const search_budget_t *budget, int64_t *stat);
+void game_restrict_root(const bitset_t *moves);
+
+#endif
@@ -0,0 +1,70 @@
+#include "tt.h"
+#include <stdlib.h>
+#include <string.h>
+
+// data = generacion (32 bits altos) | valor + 1 (32 bits bajos); 0 es entrada vacia
+
+// Usa la mayor potencia de dos de cubetas que quepa en 'memory'; con 0 no hay tabla
+int tt_init(tt_t *tt, size_t memory) {
+	tt->entries = NULL;
+	tt->buckets = 0;
+	tt->generation = 1;
+	size_t bucket_bytes = TT_BUCKET * sizeof(tt_entry_t);
+	if (memory < bucket_bytes) return 0;
+	size_t buckets = 1;
+	while (buckets * 2 * bucket_bytes <= memory) buckets *= 2;
+	tt->entries = aligned_alloc(64, buckets * bucket_bytes);
+	if (!tt->entries) return -1;
+	memset(tt->entries, 0, buckets * bucket_bytes);
+	tt->buckets = buckets;
+	return 0;
+}
+
+void tt_free(tt_t *tt) {
+	free(tt->entries);
+	tt->entries = NULL;
+	tt->buckets = 0;
+}
+
+// Invalida todas las entradas sin recorrer la tabla (los indices de nodo cambian al
+// reiniciar o compactar el arbol)
+void tt_new_generation(tt_t *tt) {
+	tt->generation++;
+	if (tt->generation == 0) tt->generation = 1;
+}
+
+static inline tt_entry_t *bucket_of(const tt_t *tt, uint64_t hash) {
+	return &tt->entries[(hash & (tt->buckets - 1)) * TT_BUCKET];
+}
+
+// Regresa el valor guardado para 'hash' en la generacion actual o -1
+int32_t tt_probe(const tt_t *tt, uint64_t hash) {
+	if (!tt->entries) return -1;
+	const tt_entry_t *bucket = bucket_of(tt, hash);
+	for (int i = 0; i < TT_BUCKET; i++) {
+		uint64_t data = __atomic_load_n(&bucket[i].data, __ATOMIC_RELAXED);
+		uint64_t check = __atomic_load_n(&bucket[i].check, __ATOMIC_RELAXED);
+		if ((check ^ data) != hash || (uint32_t)(data >> 32) != tt->generation) continue;
+		return (int32_t)(uint32_t)data - 1;
+	}
+	return -1;
+}
+
+// Reemplaza la misma clave, una entrada vacia o de otra generacion, o la elegida
+// por los bits altos del hash
+void tt_store(tt_t *tt, uint64_t hash, int32_t value) {
+	if (!tt->entries) return;
+	tt_entry_t *bucket = bucket_of(tt, hash);
+	int slot = (int)(hash >> 62);
+	for (int i = 0; i < TT_BUCKET; i++) {
+		uint64_t data = __atomic_load_n(&bucket[i].data, __ATOMIC_RELAXED);
+		uint64_t check = __atomic_load_n(&bucket[i].check, __ATOMIC_RELAXED);
+		if ((check ^ data) == hash || data == 0 || (uint32_t)(data >> 32) != tt->generation) {
+			slot = i;
+			break;
+		}
+	}
+	uint64_t data = ((uint64_t)tt->generation << 32) | (uint32_t)(value + 1);
+	__atomic_store_n(&bucket[slot].data, data, __ATOMIC_RELAXED);
+	__atomic_store_n(&bucket[slot].check, hash ^ data, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,30 @@
+#ifndef TT_H
+#define TT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Tabla de transposiciones de tamano fijo: hash de Zobrist -> indice de nodo.
+// Cubetas de 4 entradas de 16 bytes, una linea de cache por cubeta. Sin candados:
+// cada entrada guarda check = hash ^ data, asi una lectura mezclada de dos escrituras
+// simultaneas no coincide con ningun hash y se descarta (Hyatt y Mann).
+#define TT_BUCKET 4
+
+typedef struct {
+	uint64_t check;
+	uint64_t data;
+} tt_entry_t;
+
+typedef struct {
+	tt_entry_t *entries;
+	size_t buckets;
+	uint32_t generation;
+} tt_t;
+
+int tt_init(tt_t *tt, size_t memory);
+void tt_free(tt_t *tt);
+void tt_new_generation(tt_t *tt);
+int32_t tt_probe(const tt_t *tt, uint64_t hash);
+void tt_store(tt_t *tt, uint64_t hash, int32_t value);
+
+#endif
@@ -0,0 +1,81 @@
+#include "unionfind.h"
+
+static inline int uf_find(uf_t *uf, int a) {
+	while (uf->parent[a] != a) {
+		uf->parent[a] = uf->parent[uf->parent[a]];
+		a = uf->parent[a];
+	}
+	return a;
+}
+
+static inline void uf_union(uf_t *uf, int a, int b) {
+	a = uf_find(uf, a);
+	b = uf_find(uf, b);
+	if (a == b) return;
+	if (uf->rank[a] < uf->rank[b]) {
+		int t = a;
+		a = b;
+		b = t;
+	}
+	uf->parent[b] = (int16_t)a;
+	if (uf->rank[a] == uf->rank[b]) uf->rank[a]++;
+}
+
+void uf_init(uf_t *uf, int size) {
+	int n = size * size + 4;
+	uf->size = size;
+	for (int i = 0; i < n; i++) {
+		uf->parent[i] = (int16_t)i;
+		uf->rank[i] = 0;
+	}
+}
+
+void uf_from_position(uf_t *uf, const position_t *p, int size) {
+	uf_init(uf, size);
+	for (int i = 0; i < size * size; i++) {
+		if (bs_get(&p->x, i)) uf_place(uf, p, i, 'X');
+		else if (bs_get(&p->o, i)) uf_place(uf, p, i, 'O');
+	}
+}
+
+// Copia solo la parte usada por el tamano actual
+void uf_copy(uf_t *dst, const uf_t *src) {
+	int n = src->size * src->size + 4;
+	dst->size = src->size;
+	memcpy(dst->parent, src->parent, (size_t)n * sizeof(src->parent[0]));
+	memcpy(dst->rank, src->rank, (size_t)n * sizeof(src->rank[0]));
+}
+
+// Une la ficha recien colocada en pos (ya presente en p) con sus vecinas del mismo
+// color y con los lados que toca. Regresa 1 si el jugador acaba de conectar sus lados.
+int uf_place(uf_t *uf, const position_t *p, int pos, char player) {
+	int size = uf->size;
+	int n = size * size;
+	const bitset_t *stones = position_color(p, player);
+	int y = pos / size;
+	int x = pos - y * size;
+	if (player == 'X') {
+		if (x == 0) uf_union(uf, pos, n + UF_LEFT);
+		if (x == size - 1) uf_union(uf, pos, n + UF_RIGHT);
+	} else {
+		if (y == 0) uf_union(uf, pos, n + UF_TOP);
+		if (y == size - 1) uf_union(uf, pos, n + UF_BOTTOM);
+	}
+	if (y > 0) {
+		if (bs_get(stones, pos - size)) uf_union(uf, pos, pos - size);
+		if (x < size - 1 && bs_get(stones, pos - size + 1)) uf_union(uf, pos, pos - size + 1);
+	}
+	if (x < size - 1 && bs_get(stones, pos + 1)) uf_union(uf, pos, pos + 1);
+	if (y < size - 1) {
+		if (bs_get(stones, pos + size)) uf_union(uf, pos, pos + size);
+		if (x > 0 && bs_get(stones, pos + size - 1)) uf_union(uf, pos, pos + size - 1);
+	}
+	if (x > 0 && bs_get(stones, pos - 1)) uf_union(uf, pos, pos - 1);
+	return uf_connected(uf, player);
+}
+
+int uf_connected(uf_t *uf, char player) {
+	int n = uf->size * uf->size;
+	if (player == 'X') return uf_find(uf, n + UF_LEFT) == uf_find(uf, n + UF_RIGHT);
+	return uf_find(uf, n + UF_TOP) == uf_find(uf, n + UF_BOTTOM);
+}
@@ -0,0 +1,27 @@
+#ifndef UNIONFIND_H
+#define UNIONFIND_H
+
+#include <stdint.h>
+#include "bitboard.h"
+
+// Conectividad incremental: union-find sobre las casillas mas cuatro nodos
+// virtuales para los lados. Con size*size casillas los lados son:
+//   n+UF_TOP, n+UF_BOTTOM (O), n+UF_LEFT, n+UF_RIGHT (X)
+#define UF_TOP 0
+#define UF_BOTTOM 1
+#define UF_LEFT 2
+#define UF_RIGHT 3
+
+typedef struct {
+	int size;
+	int16_t parent[MAX_BOARD_SIZE + 4];
+	uint8_t rank[MAX_BOARD_SIZE + 4];
+} uf_t;
+
+void uf_init(uf_t *uf, int size);
+void uf_from_position(uf_t *uf, const position_t *p, int size);
+void uf_copy(uf_t *dst, const uf_t *src);
+int uf_place(uf_t *uf, const position_t *p, int pos, char player);
+int uf_connected(uf_t *uf, char player);
+
+#endif
@@ -0,0 +1,357 @@
+#include <stdlib.h>
+#include "vc.h"
+
+// Limites del calculo: soporte maximo de una conexion, conexiones guardadas por par de
+// puntos, vueltas de las reglas y tamano del almacen. Con ellos el costo queda acotado
+// incluso en 26x26; lo que no cabe simplemente no se demuestra.
+#define VC_MAX_CARRIER 14
+#define VC_LIST_MAX 4
+#define SC_LIST_MAX 6
+#define VC_ROUNDS 6
+#define VC_POOL (1 << 16)
+
+// Puntos: 0 y 1 son los lados del jugador (con los grupos que ya los tocan), luego los
+// grupos de fichas propias y al final cada casilla vacia
+#define EDGE_FIRST 0
+#define EDGE_LAST 1
+
+typedef struct {
+	bitset_t carrier;
+	int32_t next;
+	int16_t key;
+	int16_t round;
+	int16_t count;
+} vc_entry_t;
+
+typedef struct {
+	int size;
+	int words;
+	char player;
+	int n;
+	int round;
+	int16_t cell_point[MAX_BOARD_SIZE];
+	int16_t point_cell[MAX_BOARD_SIZE + 2];
+	int32_t *vc;
+	int32_t *sc;
+	vc_entry_t *pool;
+	int32_t used;
+	int full;
+} hsearch_t;
+
+static const int dx[6] = {1, 0, -1, -1, 0, 1};
+static const int dy[6] = {0, 1, 1, 0, -1, -1};
+
+// Las operaciones recorren solo las palabras que ocupa el tablero
+static int bs_disjoint(const bitset_t *a, const bitset_t *b, int words) {
+	for (int w = 0; w < words; w++) {
+		if (a->w[w] & b->w[w]) return 0;
+	}
+	return 1;
+}
+
+static int bs_subset(const bitset_t *a, const bitset_t *b, int words) {
+	for (int w = 0; w < words; w++) {
+		if (a->w[w] & ~b->w[w]) return 0;
+	}
+	return 1;
+}
+
+static int bs_count(const bitset_t *a, int words) {
+	int count = 0;
+	for (int w = 0; w < words; w++) count += __builtin_popcountll(a->w[w]);
+	return count;
+}
+
+static int bs_first(const bitset_t *a, int words) {
+	for (int w = 0; w < words; w++) {
+		if (a->w[w]) return w * 64 + __builtin_ctzll(a->w[w]);
+	}
+	return -1;
+}
+
+// Punto vecino de 'pos' en la direccion d: -1 si es del rival o queda fuera por un lado
+// que no es del jugador
+static int neighbour_point(const hsearch_t *h, int pos, int d) {
+	int size = h->size;
+	int nx = pos % size + dx[d];
+	int ny = pos / size + dy[d];
+	int out_x = (nx < 0 || nx >= size);
+	int out_y = (ny < 0 || ny >= size);
+	if (h->player == 'X' && out_x) return nx < 0 ? EDGE_FIRST : EDGE_LAST;
+	if (h->player == 'O' && out_y) return ny < 0 ? EDGE_FIRST : EDGE_LAST;
+	if (out_x || out_y) return -1;
+	return h->cell_point[ny * size + nx];
+}
+
+// Etiqueta los grupos propios; los que tocan un lado se funden con el. Regresa 1 si
+// algun grupo toca ambos lados (la partida ya esta ganada).
+static int label_points(hsearch_t *h, const position_t *p) {
+	int size = h->size;
+	int cells = size * size;
+	const bitset_t *own = position_color(p, h->player);
+	int16_t stack[MAX_BOARD_SIZE];
+	int16_t members[MAX_BOARD_SIZE];
+	for (int i = 0; i < cells; i++) h->cell_point[i] = -2;
+	h->n = 2;
+	for (int i = 0; i < cells; i++) {
+		if (!bs_get(own, i) || h->cell_point[i] != -2) continue;
+		int top = 0;
+		int count = 0;
+		int first = 0;
+		int last = 0;
+		stack[top++] = (int16_t)i;
+		h->cell_point[i] = -3;
+		while (top) {
+			int c = stack[--top];
+			members[count++] = (int16_t)c;
+			int x = c % size;
+			int y = c / size;
+			int along = (h->player == 'X') ? x : y;
+			if (along == 0) first = 1;
+			if (along == size - 1) last = 1;
+			for (int d = 0; d < 6; d++) {
+				int nx = x + dx[d];
+				int ny = y + dy[d];
+				if (nx < 0 || nx >= size || ny < 0 || ny >= size) continue;
+				int q = ny * size + nx;
+				if (bs_get(own, q) && h->cell_point[q] == -2) {
+					h->cell_point[q] = -3;
+					stack[top++] = (int16_t)q;
+				}
+			}
+		}
+		if (first && last) return 1;
+		int point = first ? EDGE_FIRST : last ? EDGE_LAST : h->n++;
+		for (int k = 0; k < count; k++) h->cell_point[members[k]] = (int16_t)point;
+	}
+	h->point_cell[EDGE_FIRST] = -1;
+	h->point_cell[EDGE_LAST] = -1;
+	for (int point = 2; point < h->n; point++) h->point_cell[point] = -1;
+	for (int i = 0; i < cells; i++) {
+		if (position_empty(p, i)) {
+			h->point_cell[h->n] = (int16_t)i;
+			h->cell_point[i] = (int16_t)h->n++;
+		} else if (h->cell_point[i] == -2) {
+			h->cell_point[i] = -1;
+		}
+	}
+	return 0;
+}
+
+static int32_t *pair_head(const hsearch_t *h, int32_t *table, int a, int b) {
+	return (a < b) ? &table[a * h->n + b] : &table[b * h->n + a];
+}
+
+// Agrega una conexion a la lista del par si no hay otra con soporte contenido en el
+// suyo; quita las que la nueva hace redundantes. Regresa 1 si la lista cambio.
+static int add_entry(hsearch_t *h, int32_t *table, int list_max, int a, int b, const bitset_t *carrier, int key) {
+	int count = bs_count(carrier, h->words);
+	if (count > VC_MAX_CARRIER) return 0;
+	int32_t *head = pair_head(h, table, a, b);
+	int length = 0;
+	for (int32_t *link = head; *link >= 0;) {
+		vc_entry_t *e = &h->pool[*link];
+		if (bs_subset(&e->carrier, carrier, h->words)) return 0;
+		if (bs_subset(carrier, &e->carrier, h->words)) {
+			*link = e->next;
+			continue;
+		}
+		length++;
+		link = &e->next;
+	}
+	if (length >= list_max) return 0;
+	if (h->used >= VC_POOL) {
+		h->full = 1;
+		return 0;
+	}
+	vc_entry_t *e = &h->pool[h->used];
+	e->carrier = *carrier;
+	e->key = (int16_t)key;
+	e->round = (int16_t)h->round;
+	e->count = (int16_t)count;
+	e->next = *head;
+	*head = h->used++;
+	return 1;
+}
+
+// Regla AND sobre el punto intermedio z: VC(x,z) y VC(z,y) con soportes disjuntos que
+// no contienen al otro extremo dan VC(x,y) si z es propio, o SC(x,y) con clave z si
+// z esta vacio. Cada conexion guarda la vuelta en que nacio y solo se combinan pares
+// con al menos una conexion de la vuelta anterior o de la actual.
+static int and_rule(hsearch_t *h, int z) {
+	int16_t ends[MAX_BOARD_SIZE + 2];
+	int count = 0;
+	int changed = 0;
+	int zcell = h->point_cell[z];
+	int since = h->round - 1;
+	for (int x = 0; x < h->n; x++) {
+		if (x != z && *pair_head(h, h->vc, x, z) >= 0) ends[count++] = (int16_t)x;
+	}
+	for (int i = 0; i < count; i++) {
+		int x = ends[i];
+		int xcell = h->point_cell[x];
+		for (int j = i + 1; j < count; j++) {
+			int y = ends[j];
+			int ycell = h->point_cell[y];
+			for (int32_t a = *pair_head(h, h->vc, x, z); a >= 0; a = h->pool[a].next) {
+				const bitset_t *c1 = &h->pool[a].carrier;
+				if (ycell >= 0 && bs_get(c1, ycell)) continue;
+				for (int32_t b = *pair_head(h, h->vc, z, y); b >= 0; b = h->pool[b].next) {
+					if (h->pool[a].round < since && h->pool[b].round < since) continue;
+					if (h->pool[a].count + h->pool[b].count + (zcell >= 0) > VC_MAX_CARRIER) continue;
+					const bitset_t *c2 = &h->pool[b].carrier;
+					if (xcell >= 0 && bs_get(c2, xcell)) continue;
+					if (!bs_disjoint(c1, c2, h->words)) continue;
+					bitset_t carrier;
+					for (int w = 0; w < h->words; w++) carrier.w[w] = c1->w[w] | c2->w[w];
+					if (zcell < 0) {
+						changed |= add_entry(h, h->vc, VC_LIST_MAX, x, y, &carrier, -1);
+					} else {
+						bs_set(&carrier, zcell);
+						changed |= add_entry(h, h->sc, SC_LIST_MAX, x, y, &carrier, zcell);
+					}
+				}
+			}
+		}
+	}
+	return changed;
+}
+
+// Regla OR: si los soportes de varias SC entre x e y no tienen casilla comun, el rival
+// no puede cortarlas todas de una jugada y la union es una VC. Se prueban los pares y
+// la lista completa.
+static int or_rule(hsearch_t *h, int x, int y) {
+	int32_t head = *pair_head(h, h->sc, x, y);
+	if (head < 0 || h->pool[head].next < 0) return 0;
+	int fresh = 0;
+	for (int32_t a = head; a >= 0; a = h->pool[a].next) fresh |= (h->pool[a].round >= h->round - 1);
+	if (!fresh) return 0;
+	int changed = 0;
+	bitset_t meet;
+	bitset_t all;
+	bs_clear(&all);
+	memset(meet.w, 0xff, sizeof(meet.w));
+	for (int32_t a = head; a >= 0; a = h->pool[a].next) {
+		const bitset_t *c1 = &h->pool[a].carrier;
+		for (int w = 0; w < h->words; w++) {
+			meet.w[w] &= c1->w[w];
+			all.w[w] |= c1->w[w];
+		}
+		for (int32_t b = h->pool[a].next; b >= 0; b = h->pool[b].next) {
+			const bitset_t *c2 = &h->pool[b].carrier;
+			if (!bs_disjoint(c1, c2, h->words)) continue;
+			bitset_t carrier;
+			for (int w = 0; w < h->words; w++) carrier.w[w] = c1->w[w] | c2->w[w];
+			changed |= add_entry(h, h->vc, VC_LIST_MAX, x, y, &carrier, -1);
+		}
+	}
+	if (bs_first(&meet, h->words) < 0) changed |= add_entry(h, h->vc, VC_LIST_MAX, x, y, &all, -1);
+	return changed;
+}
+
+// Calcula las conexiones de 'player' hasta que las reglas dejan de producir nuevas o se
+// agotan las vueltas. Regresa 1 si el jugador ya esta conectado.
+static int hsearch_run(hsearch_t *h, const position_t *p, int size, char player) {
+	h->size = size;
+	h->words = (size * size + 63) / 64;
+	h->player = player;
+	h->used = 0;
+	h->full = 0;
+	h->round = 0;
+	if (label_points(h, p)) return 1;
+	int n = h->n;
+	for (int i = 0; i < n * n; i++) {
+		h->vc[i] = -1;
+		h->sc[i] = -1;
+	}
+	bitset_t none;
+	bs_clear(&none);
+	for (int i = 0; i < size * size; i++) {
+		int a = h->cell_point[i];
+		if (a < 0 || h->point_cell[a] != i) continue;
+		for (int d = 0; d < 6; d++) {
+			int b = neighbour_point(h, i, d);
+			if (b >= 0 && b != a) add_entry(h, h->vc, VC_LIST_MAX, a, b, &none, -1);
+		}
+	}
+	for (int round = 0; round < VC_ROUNDS && !h->full; round++) {
+		int changed = 0;
+		h->round = round + 1;
+		for (int z = 0; z < n; z++) changed |= and_rule(h, z);
+		for (int x = 0; x < n; x++) {
+			for (int y = x + 1; y < n; y++) changed |= or_rule(h, x, y);
+		}
+		if (!changed) break;
+	}
+	return 0;
+}
+
+// Interseccion de los soportes de todas las conexiones entre los lados en 'table';
+// regresa 0 si no hay ninguna
+static int edge_meet(const hsearch_t *h, int32_t *table, bitset_t *meet) {
+	int32_t head = *pair_head(h, table, EDGE_FIRST, EDGE_LAST);
+	if (head < 0) return 0;
+	bs_clear(meet);
+	memset(meet->w, 0xff, sizeof(uint64_t) * h->words);
+	for (int32_t a = head; a >= 0; a = h->pool[a].next) {
+		for (int w = 0; w < h->words; w++) meet->w[w] &= h->pool[a].carrier.w[w];
+	}
+	return 1;
+}
+
+int vc_analyze(const position_t *p, int size, char player, vc_result_t *result) {
+	if (!p || !result || size <= 0 || size * size > MAX_BOARD_SIZE) return 0;
+	char rival = (player == 'X') ? 'O' : 'X';
+	int points = size * size + 2;
+	hsearch_t *h = malloc(sizeof(*h));
+	if (!h) return 0;
+	h->vc = malloc(sizeof(int32_t) * points * points);
+	h->sc = malloc(sizeof(int32_t) * points * points);
+	h->pool = malloc(sizeof(vc_entry_t) * VC_POOL);
+	if (!h->vc || !h->sc || !h->pool) {
+		free(h->vc);
+		free(h->sc);
+		free(h->pool);
+		free(h);
+		return 0;
+	}
+
+	result->status = VC_OPEN;
+	result->move = -1;
+	result->mustplay_count = 0;
+	bs_clear(&result->mustplay);
+
+	// Quien mueve gana si ya tiene una VC entre sus lados (juega dentro del soporte,
+	// lo que nunca la rompe) o una SC (juega la clave)
+	if (!hsearch_run(h, p, size, player)) {
+		int32_t vc = *pair_head(h, h->vc, EDGE_FIRST, EDGE_LAST);
+		int32_t sc = *pair_head(h, h->sc, EDGE_FIRST, EDGE_LAST);
+		if (vc >= 0 && bs_first(&h->pool[vc].carrier, h->words) >= 0) {
+			result->status = VC_WIN;
+			result->move = bs_first(&h->pool[vc].carrier, h->words);
+		} else if (sc >= 0) {
+			result->status = VC_WIN;
+			result->move = h->pool[sc].key;
+		}
+	}
+
+	// Si no, las conexiones del rival: una VC es derrota; sus SC obligan a jugar en la
+	// interseccion de sus soportes, y si esta es vacia tampoco hay defensa
+	if (result->status == VC_OPEN && !hsearch_run(h, p, size, rival)) {
+		bitset_t meet;
+		if (*pair_head(h, h->vc, EDGE_FIRST, EDGE_LAST) >= 0) {
+			result->status = VC_LOSS;
+			edge_meet(h, h->vc, &result->mustplay);
+		} else if (edge_meet(h, h->sc, &meet)) {
+			if (bs_first(&meet, h->words) < 0) result->status = VC_LOSS;
+			result->mustplay = meet;
+		}
+		result->mustplay_count = bs_count(&result->mustplay, h->words);
+	}
+
+	free(h->vc);
+	free(h->sc);
+	free(h->pool);
+	free(h);
+	return 1;
+}
@@ -0,0 +1,30 @@
+#ifndef VC_H
+#define VC_H
+
+#include "bitboard.h"
+
+// Conexiones virtuales al estilo H-search. Para cada jugador se calculan, entre sus
+// dos lados, conexiones virtuales (VC: conecta aunque el rival juegue primero) y
+// semiconexiones (SC: conecta si juega primero en la casilla clave), con su soporte
+// (las casillas vacias que necesitan).
+typedef enum {
+	VC_OPEN,
+	VC_WIN,
+	VC_LOSS
+} vc_status_t;
+
+// Para el jugador en turno:
+//  VC_WIN: gana jugando 'move'
+//  VC_LOSS: el rival ya tiene una VC entre sus lados
+//  VC_OPEN: sin resultado; si el rival amenaza con una SC, 'mustplay' son las
+//           casillas que cortan todas sus amenazas (mustplay_count == 0 si no hay)
+typedef struct {
+	vc_status_t status;
+	int move;
+	bitset_t mustplay;
+	int mustplay_count;
+} vc_result_t;
+
+int vc_analyze(const position_t *p, int size, char player, vc_result_t *result);
+
+#endif